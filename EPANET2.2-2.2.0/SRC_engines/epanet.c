@@ -235,6 +235,77 @@ int DLLEXPORT EN_open(EN_Project p, const char *inpFile, const char *rptFile,
   return errcode;
 }
 
+int DLLEXPORT EN_openbuffer(EN_Project p, const char *inpBuffer, long bufferSize,
+                            const char *rptFile, const char *outFile)
+/*----------------------------------------------------------------
+ **  Input:   inpBuffer = contents of an input file
+ **           bufferSize = number of bytes in inpBuffer
+ **           rptFile = name of report file (NULL for no report)
+ **           outFile = name of binary output file
+ **  Output:  none
+ **  Returns: error code
+ **  Purpose: reads in network data held in memory
+ **
+ **  Notes:   as EN_open() but the network is parsed from inpBuffer,
+ **           which need only remain valid during this call. If
+ **           rptFile is NULL no report is written and no files are
+ **           opened.
+ **----------------------------------------------------------------
+ */
+{
+  int errcode = 0;
+
+  // Set system flags
+  p->Openflag = FALSE;
+  p->hydraul.OpenHflag = FALSE;
+  p->quality.OpenQflag = FALSE;
+  p->outfile.SaveHflag = FALSE;
+  p->outfile.SaveQflag = FALSE;
+  p->Warnflag = FALSE;
+  p->report.Messageflag = (rptFile != NULL);
+  p->report.Rptflag = 1;
+
+  // Initialize data arrays to NULL
+  initpointers(p);
+
+  // Attach input buffer & open report file
+  ERRCODE(openbuffer(p, inpBuffer, bufferSize, rptFile, outFile));
+  if (errcode > 0)
+  {
+    errmsg(p, errcode);
+    return errcode;
+  }
+
+  // Allocate memory for project's data arrays
+  writewin(p->viewprog, FMT100);
+  ERRCODE(netsize(p));
+  ERRCODE(allocdata(p));
+
+  // Read input data
+  ERRCODE(getdata(p));
+
+  // Detach input buffer
+  p->parser.InBuffer = NULL;
+  p->parser.InBufferSize = 0;
+  p->parser.InBufferPos = 0;
+
+  // If using previously saved hydraulics file then open it
+  if (p->outfile.Hydflag == USE) ERRCODE(openhydfile(p));
+
+  // Write input summary to report file
+  if (!errcode)
+  {
+    if (p->report.RptFile != NULL)
+    {
+      if (p->report.Summaryflag) writesummary(p);
+      writetime(p, FMT104);
+    }
+    p->Openflag = TRUE;
+  }
+  else errmsg(p, errcode);
+  return errcode;
+}
+
 int DLLEXPORT EN_gettitle(EN_Project p, char *line1, char *line2, char *line3)
 /*----------------------------------------------------------------
 **  Input:   None
@@ -1187,6 +1258,12 @@ int DLLEXPORT EN_getoption(EN_Project p, int option, double *value)
     case EN_CONCENLIMIT:
         v = qual->Climit * p->Ucf[QUALITY];
         break;
+    case EN_LINSOLVER:
+        v = hyd->smatrix.Supernodal;
+        break;
+    case EN_HWPOW:
+        v = hyd->HWapprox;
+        break;
 
     default:
         return 251;
@@ -1344,6 +1421,29 @@ int DLLEXPORT EN_setoption(EN_Project p, int option, double value)
         qual->Climit = value / p->Ucf[QUALITY];
         break;
 
+    case EN_LINSOLVER:
+        if (value == EN_SCALARCHOL || value == EN_SUPERNODALCHOL)
+        {
+            // an open solver only has the supernodal memory if it
+            // was opened with the supernodal solver (see SMATRIX.C)
+            if (value == EN_SUPERNODALCHOL && hyd->OpenHflag)
+            {
+                i = allocsupernodal(p);
+                if (i) return i;
+            }
+            hyd->smatrix.Supernodal = (int)value;
+        }
+        else return 213;
+        break;
+
+    case EN_HWPOW:
+        if (value == EN_LIBMPOW || value == EN_APPROXPOW)
+        {
+            hyd->HWapprox = (int)value;
+        }
+        else return 213;
+        break;
+
     default:
         return 251;
     }
@@ -3849,6 +3949,7 @@ int DLLEXPORT EN_setlinkvalue(EN_Project p, int index, int property, double valu
             if (value <= 0.0) return 211;
             Link[index].Km = 0.02517 * value / SQR(Link[index].Diam) /
                              SQR(Link[index].Diam);
+            resistcoeff(p, index);             // Update pipe coeffs.
         }
         break;
 
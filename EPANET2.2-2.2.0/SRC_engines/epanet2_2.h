@@ -126,6 +126,23 @@ typedef struct Project *EN_Project;
   int DLLEXPORT EN_open(EN_Project ph, const char *inpFile, const char *rptFile,
                 const char *outFile);
 
+  /**
+  @brief Reads in network data held in memory in EPANET input file format.
+  @param ph an EPANET project handle.
+  @param inpBuffer the contents of an EPANET-formatted input file.
+  @param bufferSize the number of bytes in inpBuffer.
+  @param rptFile the name of a report file to be created ("" to use stdout, NULL if no
+  report should be written).
+  @param outFile the name of a binary output file to be created (or "" if not needed).
+  @return an error code.
+
+  As ::EN_open except that no input file is read. The buffer need only remain valid for the
+  duration of the call. When rptFile is NULL no file is opened, so a network can be loaded
+  without any file I/O.
+  */
+  int DLLEXPORT EN_openbuffer(EN_Project ph, const char *inpBuffer, long bufferSize,
+                const char *rptFile, const char *outFile);
+
   /**
   @brief Retrieves the title lines of the project
   @param ph an EPANET project handle.
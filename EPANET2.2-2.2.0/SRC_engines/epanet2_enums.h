@@ -317,9 +317,31 @@ typedef enum {
   EN_BULKORDER      = 19, //!< Bulk water reaction order for pipes
   EN_WALLORDER      = 20, //!< Wall reaction order for pipes (either 0 or 1)
   EN_TANKORDER      = 21, //!< Bulk water reaction order for tanks
-  EN_CONCENLIMIT    = 22  //!< Limiting concentration for growth reactions
+  EN_CONCENLIMIT    = 22, //!< Limiting concentration for growth reactions
+  EN_LINSOLVER      = 23, //!< Linear equation solver (see @ref EN_LinearSolverType)
+  EN_HWPOW          = 24  //!< Power function of the Hazen-Williams head loss (see @ref EN_HWPowType)
 } EN_Option;
 
+/// Linear equation solvers
+/**
+These are the sparse Cholesky solvers used for the linear system at each hydraulic trial.
+They are used with @ref EN_getoption and @ref EN_setoption to get or set the @ref EN_LINSOLVER option.
+*/
+typedef enum {
+  EN_SCALARCHOL     = 0,  //!< Column-by-column sparse Cholesky (default)
+  EN_SUPERNODALCHOL = 1   //!< Supernodal Cholesky with dense blocked updates
+} EN_LinearSolverType;
+
+/// Hazen-Williams power functions
+/**
+These are the ways the flow power in the Hazen-Williams head loss of each pipe is computed.
+They are used with @ref EN_getoption and @ref EN_setoption to get or set the @ref EN_HWPOW option.
+*/
+typedef enum {
+  EN_LIBMPOW   = 0,  //!< C library pow(), one pipe at a time (default)
+  EN_APPROXPOW = 1   //!< Branch free approximation of pow() for all pipes at once, vectorized on AVX2 and NEON targets
+} EN_HWPowType;
+
 /// Simple control types
 /**
 These are the different types of simple (single statement) controls that can be applied
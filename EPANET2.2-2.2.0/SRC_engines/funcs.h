@@ -20,6 +20,9 @@ int     allocdata(Project *);
 void    freedata(Project *);
 
 int     openfiles(Project *, const char *, const char *,const char *);
+int     openbuffer(Project *, const char *, long, const char *, const char *);
+char    *inpgets(Parser *, char *, int);
+void    inprewind(Parser *);
 int     openhydfile(Project *);
 int     openoutfile(Project *);
 void    closeoutfile(Project *);
@@ -157,6 +160,10 @@ void    getenergy(Project *, int, double *, double *);
 double  tankvolume(Project *, int, double);
 double  tankgrade(Project *, int, double);
 
+// ------- SMATRIX.C -----------------
+
+int     allocsupernodal(Project *);
+
 // ------- HYDCOEFFS.C -----------------
 
 void    resistcoeff(Project *, int);
@@ -15,6 +15,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <stdint.h>
 
 #include "types.h"
 #include "funcs.h"
@@ -41,6 +42,11 @@ const double CBIG   = 1.e8;
 //void   emitterheadloss(Project *, int, double *, double *);
 //void   demandheadloss(Project *, int, double, double, double *, double *);
 
+// Constants used by hwpow()
+static const double LN2    = 6.93147180559945309417e-01;   // ln(2)
+static const double LOG2E  = 1.44269504088896340736e+00;   // 1/ln(2)
+static const double RNDINT = 6.75539944105574400000e+15;   // 1.5*2^52
+
 // Local functions
 static void    linkcoeffs(Project *pr);
 static void    nodecoeffs(Project *pr);
@@ -49,6 +55,9 @@ static void    emittercoeffs(Project *pr);
 static void    demandcoeffs(Project *pr);
 
 static void    pipecoeff(Project *pr, int k);
+static void    hwpipecoeffs(Project *pr);
+static double  hwselect(uint64_t mask, double a, double b);
+static double  hwpow(double x, double y);
 static void    DWpipecoeff(Project *pr, int k);
 static double  frictionFactor(double q, double e, double s, double *dfdq);
 
@@ -113,6 +122,21 @@ void  resistcoeff(Project *pr, int k)
         link->R = CSMALL;
         break;
     }
+
+    // Copy of pipe coeffs. used by hwpipecoeffs()
+    if (hyd->PipeR)
+    {
+        if (link->Type <= PIPE)
+        {
+            hyd->PipeR[k] = link->R;
+            hyd->PipeKm[k] = link->Km;
+        }
+        else
+        {
+            hyd->PipeR[k] = 0.0;
+            hyd->PipeKm[k] = 0.0;
+        }
+    }
 }
 
 
@@ -130,6 +154,14 @@ void headlosscoeffs(Project *pr)
     Hydraul *hyd = &pr->hydraul;
 
     int k;
+    int hwkernel = 0;
+
+    // Coeffs. for all open Hazen-Williams pipes at once if the
+    // EN_HWPOW option selects hwpow(). The loop only vectorizes on
+    // targets with 64-bit integer vector compares (e.g. AVX2, NEON),
+    // elsewhere pipecoeff() with libm pow() is faster.
+    hwkernel = (hyd->HWapprox && hyd->Formflag == HW && hyd->PipeR != NULL);
+    if (hwkernel) hwpipecoeffs(pr);
 
     for (k = 1; k <= net->Nlinks; ++k)
     {
@@ -137,7 +169,12 @@ void headlosscoeffs(Project *pr)
         {
         case CVPIPE:
         case PIPE:
-            pipecoeff(pr, k);
+            if (!hwkernel) pipecoeff(pr, k);
+            else if (hyd->LinkStatus[k] <= CLOSED)
+            {
+                hyd->P[k] = 1.0 / CBIG;
+                hyd->Y[k] = hyd->LinkFlow[k];
+            }
             break;
         case PUMP:
             pumpcoeff(pr, k);
@@ -209,46 +246,55 @@ void  linkcoeffs(Project *pr)
     Hydraul *hyd = &pr->hydraul;
     Smatrix *sm = &hyd->smatrix;
 
-    int   k, n1, n2;
-    Slink *link;
+    int    k, n1, n2, r1, r2;
+    int    njuncs = net->Njuncs;
+    int    *N1 = hyd->LinkN1, *N2 = hyd->LinkN2;
+    int    *Row1 = hyd->LinkRow1, *Row2 = hyd->LinkRow2;
+    int    *Ndx = sm->Ndx;
+    double *P = hyd->P, *Y = hyd->Y, *Q = hyd->LinkFlow;
+    double *Aii = sm->Aii, *Aij = sm->Aij, *F = sm->F;
+    double *Xflow = hyd->Xflow, *H = hyd->NodeHead;
 
     // Examine each link of network
+    // (end nodes and their rows are stored by openhyd() so that
+    //  the Slink structs need not be visited)
     for (k = 1; k <= net->Nlinks; ++k)
     {
-        if (hyd->P[k] == 0.0) continue;
-        link = &net->Link[k];
-        n1 = link->N1;           // Start node of link
-        n2 = link->N2;           // End node of link
+        if (P[k] == 0.0) continue;
+        n1 = N1[k];              // Start node of link
+        n2 = N2[k];              // End node of link
+        r1 = Row1[k];
+        r2 = Row2[k];
 
         // Update nodal flow excess (Xflow)
         // (Flow out of node is (-), flow into node is (+))
-        hyd->Xflow[n1] -= hyd->LinkFlow[k];
-        hyd->Xflow[n2] += hyd->LinkFlow[k];
+        Xflow[n1] -= Q[k];
+        Xflow[n2] += Q[k];
 
         // Add to off-diagonal coeff. of linear system matrix
-        sm->Aij[sm->Ndx[k]] -= hyd->P[k];
+        Aij[Ndx[k]] -= P[k];
 
         // Update linear system coeffs. associated with start node n1
         // ... node n1 is junction
-        if (n1 <= net->Njuncs)
+        if (n1 <= njuncs)
         {
-            sm->Aii[sm->Row[n1]] += hyd->P[k];   // Diagonal coeff.
-            sm->F[sm->Row[n1]] += hyd->Y[k];     // RHS coeff.
+            Aii[r1] += P[k];     // Diagonal coeff.
+            F[r1] += Y[k];       // RHS coeff.
         }
 
         // ... node n1 is a tank/reservoir
-        else sm->F[sm->Row[n2]] += (hyd->P[k] * hyd->NodeHead[n1]);
+        else F[r2] += (P[k] * H[n1]);
 
         // Update linear system coeffs. associated with end node n2
         // ... node n2 is junction
-        if (n2 <= net->Njuncs)
+        if (n2 <= njuncs)
         {
-            sm->Aii[sm->Row[n2]] += hyd->P[k];   // Diagonal coeff.
-            sm->F[sm->Row[n2]] -= hyd->Y[k];     // RHS coeff.
+            Aii[r2] += P[k];     // Diagonal coeff.
+            F[r2] -= Y[k];       // RHS coeff.
         }
 
         // ... node n2 is a tank/reservoir
-        else sm->F[sm->Row[n1]] += (hyd->P[k] * hyd->NodeHead[n2]);
+        else F[r1] += (P[k] * H[n2]);
     }
 }
 
@@ -575,6 +621,167 @@ void  pipecoeff(Project *pr, int k)
 }
 
 
+void  hwpipecoeffs(Project *pr)
+/*
+**--------------------------------------------------------------
+**   Input:   none
+**   Output:  none
+**   Purpose:  computes P & Y coefficients for all pipes using
+**             the Hazen-Williams formula.
+**
+**    This is pipecoeff() applied to every link at once using
+**    the pipe coeffs. PipeR and PipeKm stored by resistcoeff().
+**    Links that are not pipes have PipeR = 0 and their values
+**    are overwritten by headlosscoeffs(), as are those of closed
+**    pipes.
+**
+**    The loop has no branches or library calls so that it can
+**    be vectorized. The test on hgrad
+**    compares bit patterns (non-negative doubles are ordered as
+**    their values are) and the result is selected with a bit
+**    mask, since the compiler will not if-convert floating point
+**    operations that might raise an exception.
+**--------------------------------------------------------------
+*/
+{
+    Hydraul *hyd = &pr->hydraul;
+
+    int    k, n = pr->network.Nlinks;
+    double *Q = hyd->LinkFlow, *R = hyd->PipeR, *Km = hyd->PipeKm;
+    double *P = hyd->P, *Y = hyd->Y;
+    double hexp = hyd->Hexp, rqtol = hyd->RQtol;
+    double hloss, hgrad, ml, q;
+    uint64_t bq, bh, brq, lin;
+
+    memcpy(&brq, &rqtol, sizeof(brq));
+    for (k = 1; k <= n; ++k)
+    {
+        memcpy(&bq, &Q[k], sizeof(bq));
+        q = fabs(Q[k]);
+        ml = Km[k];
+
+        // Friction head loss gradient
+        hgrad = hexp * R[k] * hwpow(q, hexp - 1.0);
+
+        // Friction head loss:
+        // ... use linear function for very small gradient
+        // ... otherwise use original formula
+        memcpy(&bh, &hgrad, sizeof(bh));
+        lin = 0 - (uint64_t)(bh < brq);
+        hloss = hwselect(lin, rqtol * q, hgrad * q / hexp);
+        hgrad = hwselect(lin, rqtol, hgrad);
+
+        // Contribution of minor head loss
+        hloss += ml * q * q;
+        hgrad += 2.0 * ml * q;
+
+        // Adjust head loss sign for flow direction
+        memcpy(&bh, &hloss, sizeof(bh));
+        bh ^= bq & 0x8000000000000000ULL;
+        memcpy(&hloss, &bh, sizeof(hloss));
+
+        // P and Y coeffs.
+        P[k] = 1.0 / hgrad;
+        Y[k] = hloss / hgrad;
+    }
+}
+
+
+double  hwselect(uint64_t mask, double a, double b)
+/*
+**--------------------------------------------------------------
+**   Input:   mask = all bits set or all bits clear
+**            a, b = values
+**   Output:  returns a if mask is set, otherwise b
+**   Purpose: selects between two values without a branch
+**--------------------------------------------------------------
+*/
+{
+    uint64_t ba, bb;
+
+    memcpy(&ba, &a, sizeof(ba));
+    memcpy(&bb, &b, sizeof(bb));
+    ba = (ba & mask) | (bb & ~mask);
+    memcpy(&a, &ba, sizeof(a));
+    return a;
+}
+
+
+double  hwpow(double x, double y)
+/*
+**--------------------------------------------------------------
+**   Input:   x = non-negative number
+**            y = exponent
+**   Output:  returns x^y
+**   Purpose: computes x^y as 2^(y*log2(x)) without branches
+**            or library calls for use in hwpipecoeffs().
+**            Accurate to a few units in the last place;
+**            x below 1.e-300 is treated as 1.e-300.
+**--------------------------------------------------------------
+*/
+{
+    uint64_t b, c, big;
+    int64_t  e;
+    double   m, s, s2, t, n, g, r;
+
+    // x = m * 2^e with sqrt(1/2) <= m < sqrt(2)
+    memcpy(&b, &x, sizeof(b));
+    b = (b < 0x01a56e1fc2f8f359ULL) ? 0x01a56e1fc2f8f359ULL : b;  // 1.e-300
+    e = (int64_t)(b >> 52) - 1023;
+    b = (b & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+    big = (b > 0x3ff6a09e667f3bcdULL);                          // sqrt(2)
+    e += big;
+    b -= big << 52;
+    memcpy(&m, &b, sizeof(m));
+
+    // ln(m) = 2*atanh(s) with s = (m-1)/(m+1), |s| < 0.172
+    s = (m - 1.0) / (m + 1.0);
+    s2 = s * s;
+    t = 1.0/21.0;
+    t = 1.0/19.0 + s2*t;
+    t = 1.0/17.0 + s2*t;
+    t = 1.0/15.0 + s2*t;
+    t = 1.0/13.0 + s2*t;
+    t = 1.0/11.0 + s2*t;
+    t = 1.0/9.0 + s2*t;
+    t = 1.0/7.0 + s2*t;
+    t = 1.0/5.0 + s2*t;
+    t = 1.0/3.0 + s2*t;
+    t = 1.0 + s2*t;
+
+    // y*log2(x) = n + g/ln(2) with n an integer and |g| <= ln(2)/2
+    // (adding RNDINT rounds t to an integer held in the low bits)
+    t = y * ((double)e + 2.0 * s * t * LOG2E);
+    n = t + RNDINT;
+    memcpy(&b, &n, sizeof(b));
+    n -= RNDINT;
+    g = (t - n) * LN2;
+
+    // e^g by its Taylor series
+    r = 1.0/6227020800.0;
+    r = 1.0/479001600.0 + g*r;
+    r = 1.0/39916800.0 + g*r;
+    r = 1.0/3628800.0 + g*r;
+    r = 1.0/362880.0 + g*r;
+    r = 1.0/40320.0 + g*r;
+    r = 1.0/5040.0 + g*r;
+    r = 1.0/720.0 + g*r;
+    r = 1.0/120.0 + g*r;
+    r = 1.0/24.0 + g*r;
+    r = 1.0/6.0 + g*r;
+    r = 0.5 + g*r;
+    r = 1.0 + g*r;
+    r = 1.0 + g*r;
+
+    // r * 2^n (n is added to the exponent bits of r)
+    c = (b - 0x4338000000000000ULL) << 52;                       // RNDINT
+    memcpy(&b, &r, sizeof(b));
+    b += c;
+    memcpy(&r, &b, sizeof(r));
+    return r;
+}
+
+
 void DWpipecoeff(Project *pr, int k)
 /*
 **--------------------------------------------------------------
@@ -63,6 +63,17 @@ int  openhyd(Project *pr)
     // Allocate memory for hydraulic variables
     ERRCODE(allocmatrix(pr));
 
+    // Store the end nodes and matrix rows of each link
+    // (see linkcoeffs() in HYDCOEFFS.C)
+    if (!errcode) for (i = 1; i <= pr->network.Nlinks; ++i)
+    {
+        link = &pr->network.Link[i];
+        pr->hydraul.LinkN1[i] = link->N1;
+        pr->hydraul.LinkN2[i] = link->N2;
+        pr->hydraul.LinkRow1[i] = pr->hydraul.smatrix.Row[link->N1];
+        pr->hydraul.LinkRow2[i] = pr->hydraul.smatrix.Row[link->N2];
+    }
+
     // Check for unconnected nodes
     if (!errcode) for (i = 1; i <= pr->network.Njuncs; ++i)
     {
@@ -176,6 +187,10 @@ void inithyd(Project *pr, int initflag)
     time->Htime = 0;
     time->Hydstep = 0;
     time->Rtime = time->Rstep;
+
+    // Reset solver timers
+    hyd->AssemblyTime = 0.0;
+    hyd->SolveTime = 0.0;
 }
 
 
@@ -311,12 +326,24 @@ int  allocmatrix(Project *pr)
                                    sizeof(double));
     hyd->OldStatus = (StatusType *) calloc(net->Nlinks+net->Ntanks+1,
                                            sizeof(StatusType));
+    hyd->PipeR    = (double *) calloc(net->Nlinks+1, sizeof(double));
+    hyd->PipeKm   = (double *) calloc(net->Nlinks+1, sizeof(double));
+    hyd->LinkN1   = (int *) calloc(net->Nlinks+1, sizeof(int));
+    hyd->LinkN2   = (int *) calloc(net->Nlinks+1, sizeof(int));
+    hyd->LinkRow1 = (int *) calloc(net->Nlinks+1, sizeof(int));
+    hyd->LinkRow2 = (int *) calloc(net->Nlinks+1, sizeof(int));
     ERRCODE(MEMCHECK(hyd->P));
     ERRCODE(MEMCHECK(hyd->Y));
     ERRCODE(MEMCHECK(hyd->DemandFlow));
     ERRCODE(MEMCHECK(hyd->EmitterFlow));
     ERRCODE(MEMCHECK(hyd->Xflow));
     ERRCODE(MEMCHECK(hyd->OldStatus));
+    ERRCODE(MEMCHECK(hyd->PipeR));
+    ERRCODE(MEMCHECK(hyd->PipeKm));
+    ERRCODE(MEMCHECK(hyd->LinkN1));
+    ERRCODE(MEMCHECK(hyd->LinkN2));
+    ERRCODE(MEMCHECK(hyd->LinkRow1));
+    ERRCODE(MEMCHECK(hyd->LinkRow2));
     return errcode;
 }
 
@@ -338,6 +365,14 @@ void  freematrix(Project *pr)
     free(hyd->EmitterFlow);
     free(hyd->Xflow);
     free(hyd->OldStatus);
+
+    // these are checked by resistcoeff() (see HYDCOEFFS.C)
+    FREE(hyd->PipeR);
+    FREE(hyd->PipeKm);
+    FREE(hyd->LinkN1);
+    FREE(hyd->LinkN2);
+    FREE(hyd->LinkRow1);
+    FREE(hyd->LinkRow2);
 }
 
 
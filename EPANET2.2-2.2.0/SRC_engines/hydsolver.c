@@ -16,6 +16,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
 
 #include "types.h"
 #include "funcs.h"
@@ -40,6 +41,7 @@ extern int  valvestatus(Project *);    //(see HYDSTATUS.C)
 extern int  linkstatus(Project *);     //(see HYDSTATUS.C)
 
 // Local functions
+static double walltime(void);
 static int    badvalve(Project *, int);
 static int    pswitch(Project *);
 
@@ -94,6 +96,7 @@ int  hydsolve(Project *pr, int *iter, double *relerr)
     int    statChange;            // Non-valve status change flag
     Hydbalance hydbal;            // Hydraulic balance errors
     double fullDemand;            // Full demand for a node (cfs)
+    double t0, t1;                // Wall clock times (sec)
 
     // Initialize status checking & relaxation factor
     nextcheck = hyd->CheckFreq;
@@ -118,9 +121,22 @@ int  hydsolve(Project *pr, int *iter, double *relerr)
         // head loss gradients, & F = flow correction terms.
         // Solution for H is returned in F from call to linsolve().
 
-        headlosscoeffs(pr);
-        matrixcoeffs(pr);
-        errcode = linsolve(sm, net->Njuncs);
+        if (hyd->Timing)
+        {
+            t0 = walltime();
+            headlosscoeffs(pr);
+            matrixcoeffs(pr);
+            t1 = walltime();
+            errcode = linsolve(sm, net->Njuncs);
+            hyd->AssemblyTime += t1 - t0;
+            hyd->SolveTime += walltime() - t1;
+        }
+        else
+        {
+            headlosscoeffs(pr);
+            matrixcoeffs(pr);
+            errcode = linsolve(sm, net->Njuncs);
+        }
 
         // Matrix ill-conditioning problem - if control valve causing problem,
         // fix its status & continue, otherwise quit with no solution.
@@ -212,6 +228,24 @@ int  hydsolve(Project *pr, int *iter, double *relerr)
 }
 
 
+double  walltime(void)
+/*
+**--------------------------------------------------------------
+**  Input:   none
+**  Output:  returns wall clock time in seconds
+**  Purpose: times the steps of hydsolve() when Timing is set
+**           (clock() is not used as it measures the CPU time
+**           of all threads in the process)
+**--------------------------------------------------------------
+*/
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + 1.e-9 * (double)ts.tv_nsec;
+}
+
+
 int  badvalve(Project *pr, int n)
 /*
 **-----------------------------------------------------------------
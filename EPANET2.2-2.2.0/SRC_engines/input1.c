@@ -57,7 +57,7 @@ int getdata(Project *pr)
     initreport(&pr->report);
 
     // Read in network data
-    rewind(pr->parser.InFile);
+    inprewind(&pr->parser);
     ERRCODE(readdata(pr));
 
     // Adjust data and convert it to internal units
@@ -126,6 +126,9 @@ void setdefaults(Project *pr)
     hyd->CheckFreq = CHECKFREQ;
     hyd->MaxCheck = MAXCHECK;
     hyd->DampLimit = DAMPLIMIT;
+    hyd->smatrix.Supernodal = 0; // Scalar linear eqn. solver
+    hyd->Timing = 0;             // Solver steps not timed
+    hyd->HWapprox = 0;           // H-W coeffs. use libm pow()
 
     qual->Qualflag = NONE;      // No quality simulation
     qual->Ctol = MISSING;       // No pre-set quality tolerance
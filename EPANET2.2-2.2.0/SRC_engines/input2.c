@@ -23,6 +23,11 @@ Last Updated: 10/29/2019
 
 #define MAXERRS 10      // Max. input errors reported
 
+// Reentrant strtok() - projects may be read on several threads at once
+#ifdef _WIN32
+#define strtok_r strtok_s
+#endif
+
 extern char *SectTxt[]; // Input section keywords (see ENUMSTXT.H)
 
 // Exported functions
@@ -55,6 +60,7 @@ int netsize(Project *pr)
 
     char line[MAXLINE + 1]; // Line from input data file
     char *tok;              // First token of line
+    char *save;             // Position in line for strtok_r()
     int sect, newsect;      // Input data sections
     int errcode = 0;        // Error code
     Spattern *pattern;
@@ -83,11 +89,11 @@ int netsize(Project *pr)
     parser->MaxPats = pr->network.Npats;
 
     // Make a pass through input file counting number of each object
-    if (parser->InFile == NULL) return 0;
-    while (fgets(line, MAXLINE, parser->InFile) != NULL)
+    if (parser->InFile == NULL && parser->InBuffer == NULL) return 0;
+    while (inpgets(parser, line, MAXLINE) != NULL)
     {
         // Skip blank lines & those beginning with a comment
-        tok = strtok(line, SEPSTR);
+        tok = strtok_r(line, SEPSTR, &save);
         if (tok == NULL) continue;
         if (*tok == ';') continue;
 
@@ -185,7 +191,7 @@ int readdata(Project *pr)
     errsum = 0;
 
     // Read each line from input file
-    while (fgets(line, MAXLINE, parser->InFile) != NULL)
+    while (inpgets(parser, line, MAXLINE) != NULL)
     {
         // Make copy of line and scan for tokens
         strcpy(wline, line);
@@ -758,16 +764,16 @@ double hour(char *time, char *units)
 {
     int n;
     double y[3];
-    char *s;
+    char *s, *save;
 
     // Separate clock time into hrs, min, sec
     for (n = 0; n < 3; ++n) y[n] = 0.0;
     n = 0;
-    s = strtok(time, ":");
+    s = strtok_r(time, ":", &save);
     while (s != NULL && n <= 3)
     {
         if (!getfloat(s, &y[n])) return -1.0;
-        s = strtok(NULL, ":");
+        s = strtok_r(NULL, ":", &save);
         ++n;
     }
 
@@ -38,6 +38,7 @@ int openfiles(Project *pr, const char *f1, const char *f2, const char *f3)
 {
     // Initialize file pointers to NULL
     pr->parser.InFile = NULL;
+    pr->parser.InBuffer = NULL;
     pr->report.RptFile = NULL;
     pr->outfile.OutFile = NULL;
     pr->outfile.HydFile = NULL;
@@ -73,6 +74,101 @@ int openfiles(Project *pr, const char *f1, const char *f2, const char *f3)
     return 0;
 }
 
+int openbuffer(Project *pr, const char *buffer, long size, const char *f2,
+               const char *f3)
+/*----------------------------------------------------------------
+**  Input:   buffer = contents of input file
+**           size = number of bytes in buffer
+**           f2 = pointer to name of report file (or NULL)
+**           f3 = pointer to name of binary output file
+**  Output:  none
+**  Returns: error code
+**  Purpose: attaches input buffer & opens report file
+**----------------------------------------------------------------
+*/
+{
+    // Initialize file pointers to NULL
+    pr->parser.InFile = NULL;
+    pr->report.RptFile = NULL;
+    pr->outfile.OutFile = NULL;
+    pr->outfile.HydFile = NULL;
+    pr->outfile.TmpOutFile = NULL;
+
+    // Attach input buffer
+    if (buffer == NULL) return 302;
+    pr->parser.InBuffer = buffer;
+    pr->parser.InBufferSize = size;
+    pr->parser.InBufferPos = 0;
+
+    // Save file names
+    pr->parser.InpFname[0] = '\0';
+    pr->report.Rpt1Fname[0] = '\0';
+    if (f2 != NULL) strncpy(pr->report.Rpt1Fname, f2, MAXFNAME);
+    strncpy(pr->outfile.OutFname, f3, MAXFNAME);
+    if (strlen(f3) > 0) pr->outfile.Outflag = SAVE;
+    else
+    {
+        pr->outfile.Outflag = SCRATCH;
+        strcpy(pr->outfile.OutFname, pr->TmpOutFname);
+    }
+    if (f2 != NULL && strlen(f3) > 0 && strcomp(f2, f3)) return 301;
+
+    // Attempt to open report file (no report if f2 is NULL)
+    if (f2 == NULL) return 0;
+    if (strlen(f2) == 0) pr->report.RptFile = stdout;
+    else
+    {
+        pr->report.RptFile = fopen(f2, "wt");
+        if (pr->report.RptFile == NULL) return 303;
+    }
+    writelogo(pr);
+    return 0;
+}
+
+char *inpgets(Parser *parser, char *line, int size)
+/*----------------------------------------------------------------
+**  Input:   size = max. number of characters to read (incl. '\0')
+**  Output:  line = next line of input
+**  Returns: line or NULL at end of input
+**  Purpose: reads a line from the input file or input buffer in
+**           the same way as fgets()
+**----------------------------------------------------------------
+*/
+{
+    int  n = 0;
+    char c;
+
+    if (parser->InFile != NULL) return fgets(line, size, parser->InFile);
+    if (parser->InBuffer == NULL) return NULL;
+    if (parser->InBufferPos >= parser->InBufferSize) return NULL;
+
+    while (n < size - 1 && parser->InBufferPos < parser->InBufferSize)
+    {
+        c = parser->InBuffer[parser->InBufferPos++];
+        if (c == '\0')
+        {
+            parser->InBufferPos = parser->InBufferSize;
+            break;
+        }
+        line[n++] = c;
+        if (c == '\n') break;
+    }
+    line[n] = '\0';
+    return (n > 0) ? line : NULL;
+}
+
+void inprewind(Parser *parser)
+/*----------------------------------------------------------------
+**  Input:   none
+**  Output:  none
+**  Purpose: returns to the start of the input file or buffer
+**----------------------------------------------------------------
+*/
+{
+    if (parser->InFile != NULL) rewind(parser->InFile);
+    parser->InBufferPos = 0;
+}
+
 int openhydfile(Project *pr)
 /*----------------------------------------------------------------
 ** Input:   none
@@ -253,6 +349,12 @@ void initpointers(Project *pr)
     pr->hydraul.P = NULL;
     pr->hydraul.Y = NULL;
     pr->hydraul.Xflow = NULL;
+    pr->hydraul.PipeR = NULL;
+    pr->hydraul.PipeKm = NULL;
+    pr->hydraul.LinkN1 = NULL;
+    pr->hydraul.LinkN2 = NULL;
+    pr->hydraul.LinkRow1 = NULL;
+    pr->hydraul.LinkRow2 = NULL;
 
     pr->quality.NodeQual = NULL;
     pr->quality.PipeRateCoeff = NULL;
@@ -278,6 +380,12 @@ void initpointers(Project *pr)
     pr->hydraul.smatrix.XLNZ = NULL;
     pr->hydraul.smatrix.NZSUB = NULL;
     pr->hydraul.smatrix.LNZ = NULL;
+    pr->hydraul.smatrix.Xsuper = NULL;
+    pr->hydraul.smatrix.Supernode = NULL;
+    pr->hydraul.smatrix.XSUB = NULL;
+    pr->hydraul.smatrix.SUB = NULL;
+    pr->hydraul.smatrix.XLX = NULL;
+    pr->hydraul.smatrix.Lx = NULL;
 
     initrules(pr);
 }
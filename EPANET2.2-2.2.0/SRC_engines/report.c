@@ -203,6 +203,7 @@ void writelogo(Project *pr)
     strcpy(rpt->DateStamp, ctime(&timer));
     rpt->PageNum = 1;
     rpt->LineNum = 2;
+    if (rpt->RptFile == NULL) return;
     fprintf(rpt->RptFile, FMT18);
     fprintf(rpt->RptFile, "%s", rpt->DateStamp);
     writeline(pr, LOGO1);
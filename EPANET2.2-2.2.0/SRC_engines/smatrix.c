@@ -16,6 +16,11 @@
    createsparse() -- called from openhyd() in HYDRAUL.C
    freesparse()   -- called from closehyd() in HYDRAUL.C
    linsolve()     -- called from netsolve() in HYDRAUL.C
+   allocsupernodal() -- called from EN_setoption() in EPANET.C
+
+ linsolve() uses either a column-by-column or a supernodal Cholesky
+ factorization, as selected by the EN_LINSOLVER option. The supernodal
+ solver's memory is only allocated once that solver is chosen.
 */
 
 #include <stdlib.h>
@@ -39,6 +44,7 @@ extern int genmmd(int *neqns, int *xadj, int *adjncy, int *invp, int *perm,
 int  createsparse(Project *);
 void freesparse(Project *);
 int  linsolve(Smatrix *, int);
+int  allocsupernodal(Project *);
 
 // Local functions
 static int     allocsmatrix(Smatrix *, int, int);
@@ -56,6 +62,9 @@ static int     storesparse(Project *, int);
 static int     sortsparse(Smatrix *, int);
 static void    transpose(int, int *, int *, int *, int *,
                          int *, int *, int *);
+static int     supernodes(Smatrix *, int);
+static void    freesupernodes(Smatrix *);
+static int     superlinsolve(Smatrix *);
 
 
 /*************************************************************************
@@ -118,6 +127,10 @@ int  createsparse(Project *pr)
     freeadjlists(net);
     ERRCODE(sortsparse(sm, net->Njuncs));
 
+    // Find the supernodes of the factorized matrix if the
+    // supernodal solver is used (see allocsupernodal())
+    if (sm->Supernodal) ERRCODE(supernodes(sm, net->Njuncs));
+
     // Allocate memory used by linear eqn. solver
     ERRCODE(alloclinsolve(sm, net->Nnodes));
 
@@ -146,6 +159,19 @@ int  allocsmatrix(Smatrix *sm, int Nnodes, int Nlinks)
     sm->link  = NULL;
     sm->first = NULL;
 
+    // Memory for supernodal solver allocated in supernodes().
+    sm->Nsuper    = 0;
+    sm->Xsuper    = NULL;
+    sm->Supernode = NULL;
+    sm->XSUB      = NULL;
+    sm->SUB       = NULL;
+    sm->XLX       = NULL;
+    sm->Slink     = NULL;
+    sm->Sfirst    = NULL;
+    sm->Relind    = NULL;
+    sm->Lx        = NULL;
+    sm->Swork     = NULL;
+
     // Memory for representing sparse matrix data structure
     sm->Order  = (int *) calloc(Nnodes+1,  sizeof(int));
     sm->Row    = (int *) calloc(Nnodes+1,  sizeof(int));
@@ -214,6 +240,55 @@ void  freesparse(Project *pr)
     FREE(sm->temp);
     FREE(sm->link);
     FREE(sm->first);
+
+    freesupernodes(sm);
+}
+
+
+void  freesupernodes(Smatrix *sm)
+/*
+**----------------------------------------------------------------
+** Input:   sm = sparse matrix struct
+** Output:  None
+** Purpose: Frees memory used by the supernodal solver
+**----------------------------------------------------------------
+*/
+{
+    FREE(sm->Xsuper);
+    FREE(sm->Supernode);
+    FREE(sm->XSUB);
+    FREE(sm->SUB);
+    FREE(sm->XLX);
+    FREE(sm->Slink);
+    FREE(sm->Sfirst);
+    FREE(sm->Relind);
+    FREE(sm->Lx);
+    FREE(sm->Swork);
+    sm->Nsuper = 0;
+}
+
+
+int  allocsupernodal(Project *pr)
+/*
+**--------------------------------------------------------------
+** Input:   none
+** Output:  returns error code
+** Purpose: allocates the supernodal solver's memory when that
+**          solver is chosen after the hydraulics were opened
+**          with the column-by-column solver
+**--------------------------------------------------------------
+*/
+{
+    Smatrix *sm = &pr->hydraul.smatrix;
+    int errcode;
+
+    // Swork is allocated last by supernodes()
+    if (sm->Swork != NULL) return 0;
+
+    freesupernodes(sm);
+    errcode = supernodes(sm, pr->network.Njuncs);
+    if (errcode) freesupernodes(sm);
+    return errcode;
 }
 
 
@@ -726,6 +801,106 @@ void  transpose(int n, int *il, int *jl, int *xl, int *ilt, int *jlt,
 }
 
 
+int  supernodes(Smatrix *sm, int n)
+/*
+**--------------------------------------------------------------
+** Input:   n = number of rows in solution matrix
+** Output:  returns error code
+** Purpose: partitions the columns of the factorized matrix into
+**          supernodes and allocates the supernodal solver's memory
+**
+** NOTE:   Consecutive columns j-1 and j belong to the same supernode
+**         when the first off-diagonal row of column j-1 is j and
+**         column j-1 has one more non-zero than column j. Since the
+**         row indexes of column j always contain those of column j-1
+**         (other than j itself), the columns then have the same
+**         structure below the supernode's dense diagonal block.
+**
+**         Each supernode is stored as a dense column-major panel in
+**         Lx, whose rows are the supernode's columns followed by the
+**         row indexes of its last column.
+**--------------------------------------------------------------
+*/
+{
+    int *XLNZ  = sm->XLNZ;
+    int *NZSUB = sm->NZSUB;
+
+    int  i, j, s, f, l, w, h, nsub, maxh;
+    long nlx;
+    int  errcode = 0;
+
+    // Identify supernodes
+    sm->Xsuper    = (int *) calloc(n+2, sizeof(int));
+    sm->Supernode = (int *) calloc(n+1, sizeof(int));
+    sm->XSUB      = (int *) calloc(n+2, sizeof(int));
+    sm->XLX       = (int *) calloc(n+2, sizeof(int));
+    ERRCODE(MEMCHECK(sm->Xsuper));
+    ERRCODE(MEMCHECK(sm->Supernode));
+    ERRCODE(MEMCHECK(sm->XSUB));
+    ERRCODE(MEMCHECK(sm->XLX));
+    if (errcode) return errcode;
+
+    s = 0;
+    for (j = 1; j <= n; ++j)
+    {
+        if (j == 1 || XLNZ[j] - XLNZ[j-1] != XLNZ[j+1] - XLNZ[j] + 1 ||
+            NZSUB[XLNZ[j-1]] != j)
+        {
+            ++s;
+            sm->Xsuper[s] = j;
+        }
+        sm->Supernode[j] = s;
+    }
+    sm->Nsuper = s;
+    sm->Xsuper[s+1] = n + 1;
+
+    // Size the row indexes and panels of each supernode
+    nsub = 0;
+    nlx = 0;
+    maxh = 0;
+    for (s = 1; s <= sm->Nsuper; ++s)
+    {
+        f = sm->Xsuper[s];
+        l = sm->Xsuper[s+1] - 1;
+        w = l - f + 1;
+        h = w + XLNZ[l+1] - XLNZ[l];
+        sm->XSUB[s] = nsub;
+        sm->XLX[s] = (int)nlx;
+        nsub += h;
+        nlx += (long)h * w;
+        if (h > maxh) maxh = h;
+    }
+    sm->XSUB[sm->Nsuper+1] = nsub;
+    sm->XLX[sm->Nsuper+1] = (int)nlx;
+    if (nlx > INT_MAX) return 101;
+
+    sm->SUB    = (int *) calloc(nsub+1, sizeof(int));
+    sm->Slink  = (int *) calloc(sm->Nsuper+2, sizeof(int));
+    sm->Sfirst = (int *) calloc(sm->Nsuper+2, sizeof(int));
+    sm->Relind = (int *) calloc(n+1, sizeof(int));
+    sm->Lx     = (double *) calloc(nlx+1, sizeof(double));
+    sm->Swork  = (double *) calloc(maxh+1, sizeof(double));
+    ERRCODE(MEMCHECK(sm->SUB));
+    ERRCODE(MEMCHECK(sm->Slink));
+    ERRCODE(MEMCHECK(sm->Sfirst));
+    ERRCODE(MEMCHECK(sm->Relind));
+    ERRCODE(MEMCHECK(sm->Lx));
+    ERRCODE(MEMCHECK(sm->Swork));
+    if (errcode) return errcode;
+
+    // Row indexes of each supernode
+    for (s = 1; s <= sm->Nsuper; ++s)
+    {
+        f = sm->Xsuper[s];
+        l = sm->Xsuper[s+1] - 1;
+        h = sm->XSUB[s];
+        for (j = f; j <= l; ++j) sm->SUB[h++] = j;
+        for (i = XLNZ[l]; i < XLNZ[l+1]; ++i) sm->SUB[h++] = NZSUB[i];
+    }
+    return errcode;
+}
+
+
 int  linsolve(Smatrix *sm, int n)
 /*
 **--------------------------------------------------------------
@@ -765,6 +940,8 @@ int  linsolve(Smatrix *sm, int n)
     int    i, istop, istrt, isub, j, k, kfirst, newk;
     double bj, diagj, ljk;
 
+    if (sm->Supernodal) return superlinsolve(sm);
+
     memset(temp,  0, (n + 1) * sizeof(double));
     memset(link,  0, (n + 1) * sizeof(int));
     memset(first, 0, (n + 1) * sizeof(int));
@@ -869,3 +1046,213 @@ int  linsolve(Smatrix *sm, int n)
    }
    return 0;
 }
+
+
+int  superlinsolve(Smatrix *sm)
+/*
+**--------------------------------------------------------------
+** Input:   sm   = sparse matrix struct
+** Output:  sm->F = solution values
+**          returns 0 if solution found, or index of
+**          equation causing system to be ill-conditioned
+** Purpose: solves sparse symmetric system of linear
+**          equations using supernodal Cholesky factorization
+**
+** NOTE:   This is the left-looking supernodal form of linsolve().
+**         Each supernode J is gathered from Aii and Aij into its
+**         dense panel, updated by every earlier supernode K with
+**         non-zeros in J's columns, and then factorized as a dense
+**         block. The update from K is first formed in the work
+**         array Swork with unit stride loops over K's panel (which
+**         the compiler can vectorize) and then scattered into J.
+**
+**         Supernodes K waiting to update J are kept in linked
+**         lists (Slink) as are the columns in linsolve(), and
+**         Sfirst[K] is the next row of K's panel to be used.
+**--------------------------------------------------------------
+*/
+{
+    double *Aii   = sm->Aii;
+    double *Aij   = sm->Aij;
+    double *B     = sm->F;
+    double *Lx    = sm->Lx;
+    double *work  = sm->Swork;
+    int *LNZ      = sm->LNZ;
+    int *XLNZ     = sm->XLNZ;
+    int *Xsuper   = sm->Xsuper;
+    int *Supernode = sm->Supernode;
+    int *XSUB     = sm->XSUB;
+    int *SUB      = sm->SUB;
+    int *XLX      = sm->XLX;
+    int *Slink    = sm->Slink;
+    int *Sfirst   = sm->Sfirst;
+    int *Relind   = sm->Relind;
+    int nsuper    = sm->Nsuper;
+
+    int    c, c2, f, h, hk, i, istrt, j, jj, k, m, newk, p1, p2, t, w, wk;
+    int    *sub, *subk;
+    double *panel, *col, *colk, *pk, bj, diagj, ljk;
+    double *c0, *c1, *c2p, *c3, l0, l1, l2, l3;
+
+    memset(Slink, 0, (nsuper + 2) * sizeof(int));
+
+    // Begin numerical factorization of matrix A into L
+    //   Compute supernode J for J = 1,...nsuper
+    for (jj = 1; jj <= nsuper; ++jj)
+    {
+        f = Xsuper[jj];
+        w = Xsuper[jj+1] - f;
+        h = XSUB[jj+1] - XSUB[jj];
+        sub = &SUB[XSUB[jj]];
+        panel = &Lx[XLX[jj]];
+
+        // Gather the columns of A into the panel
+        for (c = 0; c < w; ++c)
+        {
+            col = &panel[c*h];
+            j = f + c;
+            col[c] = Aii[j];
+            istrt = XLNZ[j];
+            m = XLNZ[j+1] - istrt;
+            for (i = 0; i < m; ++i) col[c+1+i] = Aij[LNZ[istrt+i]];
+        }
+        for (i = 0; i < h; ++i) Relind[sub[i]] = i;
+
+        // For each supernode K that affects J:
+        k = Slink[jj];
+        while (k != 0)
+        {
+            newk = Slink[k];
+            wk = Xsuper[k+1] - Xsuper[k];
+            hk = XSUB[k+1] - XSUB[k];
+            subk = &SUB[XSUB[k]];
+            pk = &Lx[XLX[k]];
+
+            // Rows p1..p2 of K lie in J's columns
+            p1 = Sfirst[k];
+            p2 = p1;
+            while (p2 + 1 < hk && subk[p2+1] < f + w) ++p2;
+            m = hk - p1;
+
+            // Outer product modification of J by rows p1.. of K
+            for (t = 0; t <= p2 - p1; ++t)
+            {
+                col = &panel[(subk[p1+t] - f)*h];
+                if (wk == 1)
+                {
+                    colk = &pk[p1];
+                    ljk = colk[t];
+                    for (i = t; i < m; ++i) col[Relind[subk[p1+i]]] -= colk[i]*ljk;
+                    continue;
+                }
+                for (i = t; i < m; ++i) work[i] = 0.0;
+                for (c = 0; c + 3 < wk; c += 4)
+                {
+                    // four columns of K at a time
+                    c0 = &pk[c*hk + p1];
+                    c1 = c0 + hk;
+                    c2p = c1 + hk;
+                    c3 = c2p + hk;
+                    l0 = c0[t]; l1 = c1[t]; l2 = c2p[t]; l3 = c3[t];
+                    for (i = t; i < m; ++i)
+                    {
+                        work[i] += c0[i]*l0 + c1[i]*l1 + c2p[i]*l2 + c3[i]*l3;
+                    }
+                }
+                for (; c < wk; ++c)
+                {
+                    colk = &pk[c*hk + p1];
+                    ljk = colk[t];
+                    for (i = t; i < m; ++i) work[i] += colk[i]*ljk;
+                }
+                for (i = t; i < m; ++i) col[Relind[subk[p1+i]]] -= work[i];
+            }
+
+            // Link K to the next supernode it affects
+            if (p2 + 1 < hk)
+            {
+                Sfirst[k] = p2 + 1;
+                i = Supernode[subk[p2+1]];
+                Slink[k] = Slink[i];
+                Slink[i] = k;
+            }
+            k = newk;
+        }
+
+        // Dense factorization of the panel
+        for (c = 0; c < w; ++c)
+        {
+            col = &panel[c*h];
+            for (c2 = 0; c2 + 3 < c; c2 += 4)
+            {
+                c0 = &panel[c2*h];
+                c1 = c0 + h;
+                c2p = c1 + h;
+                c3 = c2p + h;
+                l0 = c0[c]; l1 = c1[c]; l2 = c2p[c]; l3 = c3[c];
+                for (i = c; i < h; ++i)
+                {
+                    col[i] -= c0[i]*l0 + c1[i]*l1 + c2p[i]*l2 + c3[i]*l3;
+                }
+            }
+            for (; c2 < c; ++c2)
+            {
+                colk = &panel[c2*h];
+                ljk = colk[c];
+                for (i = c; i < h; ++i) col[i] -= colk[i]*ljk;
+            }
+            diagj = col[c];
+            if (diagj <= 0.0)        // Check for ill-conditioning
+            {
+                return f + c;
+            }
+            diagj = sqrt(diagj);
+            col[c] = diagj;
+            for (i = c + 1; i < h; ++i) col[i] /= diagj;
+        }
+
+        // Link J to the first supernode it affects
+        if (h > w)
+        {
+            Sfirst[jj] = w;
+            i = Supernode[sub[w]];
+            Slink[jj] = Slink[i];
+            Slink[i] = jj;
+        }
+    }      // next J
+
+    // Forward substitution
+    for (jj = 1; jj <= nsuper; ++jj)
+    {
+        f = Xsuper[jj];
+        w = Xsuper[jj+1] - f;
+        h = XSUB[jj+1] - XSUB[jj];
+        sub = &SUB[XSUB[jj]];
+        panel = &Lx[XLX[jj]];
+        for (c = 0; c < w; ++c)
+        {
+            col = &panel[c*h];
+            bj = B[f+c]/col[c];
+            B[f+c] = bj;
+            for (i = c + 1; i < h; ++i) B[sub[i]] -= col[i]*bj;
+        }
+    }
+
+    // Backward substitution
+    for (jj = nsuper; jj >= 1; jj--)
+    {
+        f = Xsuper[jj];
+        w = Xsuper[jj+1] - f;
+        h = XSUB[jj+1] - XSUB[jj];
+        sub = &SUB[XSUB[jj]];
+        panel = &Lx[XLX[jj]];
+        for (c = w - 1; c >= 0; c--)
+        {
+            col = &panel[c*h];
+            bj = B[f+c];
+            for (i = c + 1; i < h; ++i) bj -= col[i]*B[sub[i]];
+            B[f+c] = bj/col[c];
+        }
+    }
+    return 0;
+}
@@ -546,6 +546,9 @@ typedef struct                 // Mass Balance Components
 // Input File Parser Wrapper
 typedef struct {
   FILE *InFile;            // Input file handle
+  const char *InBuffer;    // Input data held in memory (see EN_openbuffer)
+  long InBufferSize,       // Size of InBuffer (bytes)
+       InBufferPos;        // Read position in InBuffer
 
   char
       DefPatID[MAXID + 1],     // Default demand pattern ID
@@ -692,6 +695,23 @@ typedef struct {
     *link,       // Array used by linear eqn. solver
     *first;      // Array used by linear eqn. solver
 
+  // Supernodal linear eqn. solver (see EN_LINSOLVER)
+  int
+    Supernodal,  // 1 if the supernodal solver is used
+    Nsuper,      // Number of supernodes
+    *Xsuper,     // First column of each supernode
+    *Supernode,  // Supernode containing each column
+    *XSUB,       // Start position of each supernode's row indexes in SUB
+    *SUB,        // Row indexes of each supernode (diagonal block first)
+    *XLX,        // Start position of each supernode's dense panel in Lx
+    *Slink,      // Array used by supernodal solver
+    *Sfirst,     // Array used by supernodal solver
+    *Relind;     // Array used by supernodal solver
+
+  double
+    *Lx,         // Dense column-major panels of factorized matrix
+    *Swork;      // Array used by supernodal solver
+
 } Smatrix;
 
 // Hydraulics Solver Wrapper
@@ -731,7 +751,11 @@ typedef struct {
     RelaxFactor,           // Relaxation factor for flow updating
     *P,                    // Inverse of head loss derivatives
     *Y,                    // Flow correction factors
-    *Xflow;                // Inflow - outflow at each node
+    *Xflow,                // Inflow - outflow at each node
+    *PipeR,                // Resistance coeff. of each pipe (0 for other links)
+    *PipeKm,               // Minor loss coeff. of each pipe (0 for other links)
+    AssemblyTime,          // Wall time computing matrix coeffs. (sec)
+    SolveTime;             // Wall time solving linear eqns. (sec)
 
   int
     Epat,                  // Energy cost time pattern
@@ -744,7 +768,13 @@ typedef struct {
     MaxCheck,              // Hydraulic trials limit on status checks
     OpenHflag,             // Hydraulic system opened flag
     Haltflag,              // Flag to halt simulation
-    DeficientNodes;        // Number of pressure deficient nodes
+    DeficientNodes,        // Number of pressure deficient nodes
+    Timing,                // 1 if AssemblyTime & SolveTime are recorded
+    HWapprox,              // 1 if H-W coeffs. use hwpow() (see EN_HWPOW)
+    *LinkN1,               // Start node of each link
+    *LinkN2,               // End node of each link
+    *LinkRow1,             // Matrix row of each link's start node
+    *LinkRow2;             // Matrix row of each link's end node
 
   StatusType
     *LinkStatus,           // Link status
@@ -58,6 +58,7 @@
 #include <stdexcept>
 #include <string>
 #include <memory>
+#include <numeric>
 
 HDHeuristic::HDHeuristic( void ) :  m_hydNet(nullptr),
                                     m_epanet(nullptr),
@@ -153,10 +154,10 @@ HDHeuristic::predict( const std::string& pipe_id )
     if (!pipe)
         return false;
     
-    std::vector<HydFloat> nvs = getNormValues(pipe_id); 
+    std::vector<HydFloat> nvs = getNormValues(pipe); 
 
     // upstream and down stream deficits
-    std::pair<HydFloat, HydFloat> updown_def = getNormUpDownNodeDeficit(pipe_id);
+    std::pair<HydFloat, HydFloat> updown_def = getNormUpDownNodeDeficit(pipe);
     HydFloat up_deficit   = updown_def.first;
     HydFloat down_deficit = updown_def.second; 
     
@@ -392,9 +393,14 @@ HDHeuristic::getNormPipeDiameter(const std::string& pipe_id, HydFloat diameter)
 
 std::vector<HydFloat>
 HDHeuristic::getNormValues(const std::string& pipe_id) 
+{
+    return getNormValues(m_hydNet->findPipe(pipe_id));
+}
+
+std::vector<HydFloat>
+HDHeuristic::getNormValues(const HydPipe* pipe) 
 {
     std::vector<HydFloat>  normalised_values(5, 0.0);
-    HydPipe* pipe = m_hydNet->findPipe(pipe_id);
     if (pipe)
     {
         normalised_values[Velocity]  = normalise(pipe->maxVelocity(), m_config.params()[0][0], m_config.params()[0][1]);
@@ -410,84 +416,58 @@ HDHeuristic::getNormValues(const std::string& pipe_id)
 std::pair<HydFloat,HydFloat>
 HDHeuristic::getNormUpDownNodeDeficit(const std::string& pipe_id)
 {
-    HydFloat up_head_deficit = 0.0;
-    HydFloat down_head_deficit = 0.0;
+    return getNormUpDownNodeDeficit(m_hydNet->findPipe(pipe_id));
+}
+
+HydFloat
+HDHeuristic::getNormNodeDeficit(const HydNode* node) const
+{
+    if (!node)
+        return 0.0;
+    
+    if (node->hydType() == HydType::Reservoir)
+        return -1.0;
+    
+    if (node->hydType() != HydType::Junction)
+        return 0.0;
+    
+    const HydJunction* junction = static_cast<const HydJunction*>(node);
     
     // theoretical max and min deficit values 
     HydFloat minTHeadDeficit = m_hydNet->minMaxTHeadDeficit().first;
     HydFloat maxTHeadDeficit = m_hydNet->minMaxTHeadDeficit().second;
     
-    std::string from_node;
-    std::string to_node;
-    
-    HydPipe* pipe = m_hydNet->findPipe(pipe_id);
-    if (pipe)
-    {
-        HydFloat total_flow = util::sum(pipe->flow());
-        
-        from_node = pipe->fromNodeID();
-        to_node   = pipe->toNodeID();
-        
-        if (total_flow < 0.0)
-            std::swap(from_node,to_node);
-    }
-
     // WARNING: should HDH pick a scenario index at random?
     int scenario_index = 0; 
-    const std::vector<HydJunction*>& junctions = m_hydNet->junctions();
-    for (auto i = junctions.begin(); i != junctions.end(); ++i)
+    
+    HydFloat min_head       = junction->minHead()[scenario_index];
+    HydFloat min_total_head = junction->minTotalHead();
+    
+    if ((min_head - min_total_head) > 0.0)
     {
-        HydJunction* junction = *i;
-        
-        HydFloat min_head       = junction->minHead()[scenario_index];
-        HydFloat min_total_head = junction->minTotalHead();
-        
-        // up head
-        if (junction->ID() == from_node)
-        {
-            if ((min_head - min_total_head) > 0.0)
-            {
-                if (junction->minPressure() < 0.0)
-                    up_head_deficit  = (min_head - junction->baseElevation()) / maxTHeadDeficit;
-                else up_head_deficit = (min_head - min_total_head) / maxTHeadDeficit;
-            }
-            else
-            {
-                up_head_deficit = ((min_head - min_total_head) - minTHeadDeficit) / (0.0 - minTHeadDeficit);
-                up_head_deficit -= 1.0;
-            }
-        }
-        
-        // down head
-        if (junction->ID() == to_node)
-        {
-            if ((min_head - min_total_head ) > 0.0)
-            {
-                if (junction->minPressure() < 0.0)
-                    down_head_deficit  = (min_head - junction->baseElevation()) / maxTHeadDeficit;
-                else down_head_deficit = (min_head - min_total_head) / maxTHeadDeficit;
-            }
-            else
-            {
-                down_head_deficit = ((min_head - min_total_head) - minTHeadDeficit) / (0.0 - minTHeadDeficit);
-                down_head_deficit -= 1.0;
-            }
-        }
+        if (junction->minPressure() < 0.0)
+            return (min_head - junction->baseElevation()) / maxTHeadDeficit;
+        return (min_head - min_total_head) / maxTHeadDeficit;
     }
+    
+    return (((min_head - min_total_head) - minTHeadDeficit) / (0.0 - minTHeadDeficit)) - 1.0;
+}
 
-    const std::vector<HydReservoir*>& reservoirs = m_hydNet->reservoirs();
-    for (auto i = reservoirs.begin(); i != reservoirs.end(); ++i)
-    {
-        HydReservoir* reservoir = *i;
-        
-        if (reservoir->ID() == from_node)
-            up_head_deficit = -1.0;
-        
-        if (reservoir->ID() == to_node)
-            down_head_deficit = -1.0;
-    }
+std::pair<HydFloat,HydFloat>
+HDHeuristic::getNormUpDownNodeDeficit(const HydPipe* pipe)
+{
+    if (!pipe)
+        return std::pair<HydFloat, HydFloat>(0.0, 0.0);
+    
+    HydFloat total_flow = std::accumulate(pipe->flow().begin(), pipe->flow().end(), HydFloat());
+    
+    HydNode* from_node = m_hydNet->getNode(m_hydNet->fromNodePos(pipe->pos()));
+    HydNode* to_node   = m_hydNet->getNode(m_hydNet->toNodePos(pipe->pos()));
+    
+    if (total_flow < 0.0)
+        std::swap(from_node,to_node);
 
-    return std::pair<HydFloat, HydFloat>(up_head_deficit, down_head_deficit);
+    return std::pair<HydFloat, HydFloat>(getNormNodeDeficit(from_node), getNormNodeDeficit(to_node));
 }
 
 /*
@@ -55,6 +55,8 @@
 class HydNetwork;
 class HydEPANET;
 class HydSession;
+class HydPipe;
+class HydNode;
 
 class HDHeuristic 
 {
@@ -109,12 +111,22 @@ private:
     std::vector<HydFloat>
     getNormValues(const std::string& pipe_id);
     
+    std::vector<HydFloat>
+    getNormValues(const HydPipe* pipe);
+    
     HydFloat
     getNormPipeDiameter( const std::string& pipe_id, HydFloat diameter = -1.0 );
     
     std::pair<HydFloat,HydFloat>
     getNormUpDownNodeDeficit( const std::string& pipe_id );
     
+    std::pair<HydFloat,HydFloat>
+    getNormUpDownNodeDeficit( const HydPipe* pipe );
+    
+    // the normalised head deficit of a junction, -1 for a reservoir, 0 otherwise
+    HydFloat
+    getNormNodeDeficit( const HydNode* node ) const;
+    
     HydNetwork* m_hydNet;
     HydEPANET* m_epanet;
 
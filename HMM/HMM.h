@@ -219,6 +219,19 @@ public:
     void
     seed( int s ) { m_ran.seed(s); }
     
+    // the random number generator and the last output of run() - the run state of the model (see SSHH::checkpoint)
+    const URand&
+    random( void ) const { return m_ran; }
+    
+    URand&
+    random( void ) { return m_ran; }
+    
+    const std::vector<std::vector<int>>&
+    output( void ) const { return m_y; }
+    
+    void
+    output( const std::vector<std::vector<int>>& y ) { m_y = y; }
+    
     void 
     randomise( Matrix<double>& K ); // used only in SSHH::settings; remove
     
@@ -25,18 +25,28 @@ extern "C" {
 #include "epanet2_2.h"
 }
 
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+
 int SHOW_EPANET_ERRORS = 1;
 int SHOW_EPANET_WARNINGS = 1;
 
-HydEPANET::HydEPANET( void ) : m_proj(nullptr), m_hydNet(nullptr), m_epanetOpen(0), m_extended(false)
+HydEPANET::HydEPANET( void ) : m_proj(nullptr), m_hydNet(nullptr), m_epanetOpen(0), m_hydOpen(0), m_persistent(true), m_supernodal(false), m_approxPow(false), m_extended(false), m_fileName(), m_deficitBound(std::numeric_limits<HydFloat>::max()), m_deficitBounded(false), m_iterations(0)
 {
     m_logger.getLogLevel( "HydEPANET" ); 
+    
+    m_totalRuns[0] = m_totalRuns[1] = 0;
+    m_totalIterations[0] = m_totalIterations[1] = 0;
 }
 
 HydEPANET::~HydEPANET( void )
 {
     if (m_epanetOpen)
     {   
+        closeHydraulics();
         EN_close(m_proj); 
         EN_deleteproject(m_proj);
         m_proj = nullptr;
@@ -86,7 +96,65 @@ HydEPANET::epanetError(int error_code ) const
     return false;
 }
 
+void
+HydEPANET::openHydraulics( void ) const
+// allocates the sparse matrix structures and reorders the nodes (see EPANET smatrix.c)
+{
+    int errcode = EN_openH(m_proj);
+    if (epanetError(errcode))
+        exit(EXIT_FAILURE);
+    
+    m_hydOpen = 1;
+}
 
+void
+HydEPANET::closeHydraulics( void ) const
+{
+    if (m_hydOpen)
+    {
+        int errcode = EN_closeH(m_proj);
+        if (epanetError(errcode))
+            exit(EXIT_FAILURE);
+        
+        m_hydOpen = 0;
+    }
+}
+
+void
+HydEPANET::setPersistentHydraulics( bool persistent )
+{
+    m_persistent = persistent;
+    
+    // the solver will be reopened by the next run() if required
+    if (!m_persistent && m_epanetOpen)
+        closeHydraulics();
+}
+
+void
+HydEPANET::setSupernodalSolver( bool supernodal )
+{
+    m_supernodal = supernodal;
+    
+    if (m_epanetOpen)
+    {
+        int errcode = EN_setoption(m_proj, EN_LINSOLVER, (m_supernodal) ? EN_SUPERNODALCHOL : EN_SCALARCHOL);
+        if (epanetError(errcode))
+            exit(EXIT_FAILURE);
+    }
+}
+
+void
+HydEPANET::setApproxHWPow( bool approx )
+{
+    m_approxPow = approx;
+    
+    if (m_epanetOpen)
+    {
+        int errcode = EN_setoption(m_proj, EN_HWPOW, (m_approxPow) ? EN_APPROXPOW : EN_LIBMPOW);
+        if (epanetError(errcode))
+            exit(EXIT_FAILURE);
+    }
+}
 
 double 
 HydEPANET::pressure( int node_idx ) const
@@ -145,11 +213,43 @@ HydEPANET::setValveStatus( int link_idx, LinkStatusOption status ) const
 
 HydNetwork*
 HydEPANET::load( const std::string& name )
+{
+    std::string text;
+    if (!readFile( name, text ))
+    {
+        epanetError(302); // cannot open input file
+        exit(EXIT_FAILURE);
+    }
+    
+    return load( name, text );
+}
+
+bool
+HydEPANET::readFile( const std::string& name, std::string& text )
+{
+    std::ifstream from( name, std::ios::binary );
+    if (!from)
+        return false;
+    
+    text.assign( std::istreambuf_iterator<char>(from), std::istreambuf_iterator<char>() );
+    from.close();
+    return true;
+}
+
+HydNetwork*
+HydEPANET::load( const std::string& name, const std::string& text )
+{
+    return load( name, text.data(), (long) text.size() );
+}
+
+HydNetwork*
+HydEPANET::load( const std::string& name, const char* text, long size )
 {
     int errcode = 0;
     
     if (m_epanetOpen)
     {   
+        closeHydraulics();
         EN_close(m_proj); 
         EN_deleteproject(m_proj);
         m_epanetOpen = 0;
@@ -160,10 +260,23 @@ HydEPANET::load( const std::string& name )
     if (epanetError(errcode))
         exit(EXIT_FAILURE);
     
-    char file1[] = "report.txt";
-    char file2[] = "";
-
-    errcode = EN_open(m_proj, name.c_str(), file1, file2);
+    // no report file - parsing the network is a pure CPU operation
+    errcode = EN_openbuffer(m_proj, text, size, nullptr, "");
+    if (errcode > 100)
+    {
+        // EPANET only describes input errors in the report file, so parse again to write one
+        EN_deleteproject(m_proj);
+        EN_createproject(&m_proj);
+        EN_openbuffer(m_proj, text, size, "report.txt", "");
+        
+        if (m_logger.level() >= 1)
+        {
+            Message txt(1);
+            txt << "Could not load network " << name << " - see report.txt";
+            m_logger.logMsg(txt);
+            m_logger.flush();
+        }
+    }
     if (epanetError(errcode))
         exit(EXIT_FAILURE);
     
@@ -171,6 +284,17 @@ HydEPANET::load( const std::string& name )
     char msg1[] = "MESSAGES NO";
     EN_setreport(m_proj, msg1);
     
+    errcode = EN_setoption(m_proj, EN_LINSOLVER, (m_supernodal) ? EN_SUPERNODALCHOL : EN_SCALARCHOL);
+    if (epanetError(errcode))
+        exit(EXIT_FAILURE);
+    
+    errcode = EN_setoption(m_proj, EN_HWPOW, (m_approxPow) ? EN_APPROXPOW : EN_LIBMPOW);
+    if (epanetError(errcode))
+        exit(EXIT_FAILURE);
+    
+    // time the coefficient assembly and linear solve of each iteration (see EPANET hydsolver.c)
+    m_proj->hydraul.Timing = 1;
+    
     if (m_logger.level() >= 1)
     {
         Message txt(1);
@@ -205,23 +329,100 @@ HydEPANET::load( const std::string& name )
     //
     
     m_epanetOpen = 1;
+    m_fileName = name;
+    
+    m_initialFlows.clear();
+    m_totalRuns[0] = m_totalRuns[1] = 0;
+    m_totalIterations[0] = m_totalIterations[1] = 0;
+    m_runMetrics.clear();
+    m_runHistogram.clear();
     
     // do not delete - user owns this memory now
     m_hydNet = new HydNetwork;
     
     buildNetwork();
+    m_hydNet->buildIncidence();
     m_hydNet->setName( name ); 
+    m_hydNet->reserveTimePoints( (m_extended) ? 1 + (run_time / time_step) : 1 );
     return m_hydNet;
 }
 
 void
 HydEPANET::run(void) const
 {
-    int errcode = EN_openH(m_proj);
-    if (epanetError(errcode))
-        exit(EXIT_FAILURE);
+    runSimulation( nullptr );
+}
+
+void
+HydEPANET::run( const std::vector<double>& seedFlows ) const
+{
+    runSimulation( &seedFlows );
+}
 
-    errcode = EN_initH(m_proj,0);
+void
+HydEPANET::sweepDiameter( int link_idx, const std::vector<HydFloat>& diameters, int start, const std::function<void(int)>& result ) const
+// the symbolic factorisation is kept by the persistent solver, only the numerical factorisation is repeated
+{
+    const int numDiams = (int) diameters.size();
+    if (numDiams == 0)
+        return;
+    
+    start = std::min(std::max(start, 0), numDiams - 1);
+    
+    double original = diameter(link_idx);
+    
+    // the last run is usually for the same network with the original diameter
+    std::vector<double> startFlows = m_initialFlows;
+    
+    // from start up to the largest diameter
+    for (int i = start; i < numDiams; ++i)
+    {
+        setDiameter(link_idx, diameters[i]);
+        runSimulation( (i == start) ? &startFlows : &m_initialFlows );
+        result(i);
+        
+        if (i == start)
+            startFlows = m_initialFlows;
+    }
+    
+    // from start down to the smallest diameter
+    for (int i = start - 1; i >= 0; --i)
+    {
+        setDiameter(link_idx, diameters[i]);
+        runSimulation( (i == start - 1) ? &startFlows : &m_initialFlows );
+        result(i);
+    }
+    
+    setDiameter(link_idx, original);
+}
+
+void
+HydEPANET::runSimulation( const std::vector<double>* seedFlows ) const
+{
+    // the network topology does not change between runs so a persistent solver is only opened once 
+    auto runStart = std::chrono::steady_clock::now();
+    
+    if (!m_hydOpen)
+        openHydraulics();
+
+    Hydraul *hyd = &m_proj->hydraul;
+    const int numLinks = m_proj->network.Nlinks;
+    
+    bool warm = (seedFlows && (int) seedFlows->size() == numLinks + 1);
+    
+    int errcode = 0;
+    if (warm)
+    {
+        // EN_initH with EN_NOSAVE keeps any nonzero link flows (closed links are still zeroed, see inithyd())
+        std::copy(seedFlows->begin(), seedFlows->end(), hyd->LinkFlow);
+        errcode = EN_initH(m_proj, EN_NOSAVE);
+    }
+    else
+    {
+        // a persistent solver still holds the previous run's link flows - reset them
+        // so that each run starts from the same initial flows as a newly opened solver
+        errcode = EN_initH(m_proj, (m_persistent) ? EN_INITFLOW : EN_NOSAVE);
+    }
     if (epanetError(errcode))
         exit(EXIT_FAILURE);
     
@@ -229,7 +430,11 @@ HydEPANET::run(void) const
     long currentTime = 0; // seconds
     long tstep = 0;       // seconds
     
+    m_iterations = 0;
     m_hydNet->clear();
+    m_runMetrics.clear();
+    
+    double extractTime = 0.0;
     
     while (true)
     {
@@ -238,8 +443,19 @@ HydEPANET::run(void) const
         if (epanetError(errcode))
             exit(EXIT_FAILURE);
 
+        // errcode is now 0 or a warning
+        m_runMetrics.addWarning(errcode);
+        m_runMetrics.addStep(hyd->Iterations, hyd->RelativeError);
+        m_iterations += hyd->Iterations;
+        
+        // keep the converged flows at the start of the simulation to seed similar solutions
+        if (scenario_index == 0)
+            m_initialFlows.assign(hyd->LinkFlow, hyd->LinkFlow + numLinks + 1);
+        
         // query EPANET and update the dynamic values in hydNet
+        auto extractStart = std::chrono::steady_clock::now();
         updateNetwork(scenario_index);
+        extractTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - extractStart).count();
         
         m_hydNet->addTimePoints(currentTime);
         
@@ -249,49 +465,142 @@ HydEPANET::run(void) const
         if (epanetError(errcode))
             exit(EXIT_FAILURE);
         
+        m_runMetrics.addWarning(errcode);
+        
         if (tstep <= 0)
             break;
     }
     
-    errcode = EN_closeH(m_proj);
-    if (epanetError(errcode))
-        exit(EXIT_FAILURE);
+    updateObjectives();
+    
+    ++m_totalRuns[warm];
+    m_totalIterations[warm] += m_iterations;
+    
+    m_runMetrics.setAssemblyTime(hyd->AssemblyTime);
+    m_runMetrics.setSolveTime(hyd->SolveTime);
+    m_runMetrics.setExtractTime(extractTime);
+    m_runMetrics.setRunTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count());
+    m_runHistogram.add(m_runMetrics);
+    
+    if (!m_persistent)
+        closeHydraulics();
 }
 
 void
-HydEPANET::updateNetwork(HydPipe* pipe) const
+HydEPANET::extractResults( void ) const
+// one pass over EPANET's hydraulic state for each of nodes and links, followed by unit conversion
+// the values are those returned by EN_getnodevalue/EN_getlinkvalue (see epanet.c)
 {
-    int err;
+    const Network *net  = &m_proj->network;
+    const Hydraul *hyd  = &m_proj->hydraul;
+    const Quality *qual = &m_proj->quality;
+    const double  *Ucf  = m_proj->Ucf;
     
-    // diameter can be modified
-    double diameter;
-    err = EN_getlinkvalue(m_proj, pipe->index(), EN_DIAMETER, &diameter);
-    epanetError(err);
+    const int numNodes = net->Nnodes;
+    const int numLinks = net->Nlinks;
     
-    double flow;
-    err = EN_getlinkvalue(m_proj, pipe->index(), EN_FLOW, &flow);
-    epanetError(err);
+    m_results.resize(numNodes, numLinks);
     
-    double velocity;
-    err = EN_getlinkvalue(m_proj, pipe->index(), EN_VELOCITY, &velocity);
-    epanetError(err);
+    //
+    // nodes
+    //
+    double *demand   = m_results.demand().data();
+    double *head     = m_results.head().data();
+    double *pressure = m_results.pressure().data();
+    double *nquality = m_results.nodeQuality().data();
     
-    double headloss;
-    err = EN_getlinkvalue(m_proj, pipe->index(), EN_HEADLOSS, &headloss);
-    epanetError(err);
+    for (int i = 1; i <= numNodes; ++i)
+    {
+        demand[i]   = hyd->NodeDemand[i];
+        head[i]     = hyd->NodeHead[i];
+        pressure[i] = hyd->NodeHead[i] - net->Node[i].El;
+        nquality[i] = qual->NodeQual[i];
+    }
     
-    double status;
-    err = EN_getlinkvalue(m_proj, pipe->index(), EN_STATUS, &status);
-    epanetError(err);
+    const double ucfFlow = Ucf[FLOW], ucfHead = Ucf[HEAD], ucfPressure = Ucf[PRESSURE], ucfQuality = Ucf[QUALITY];
+    for (int i = 1; i <= numNodes; ++i)
+    {
+        demand[i]   *= ucfFlow;
+        head[i]     *= ucfHead;
+        pressure[i] *= ucfPressure;
+        nquality[i] *= ucfQuality;
+    }
     
-    double quality;
-    err = EN_getlinkvalue(m_proj, pipe->index(), EN_QUALITY, &quality);
-    epanetError(err);
+    //
+    // links
+    //
+    double *flow      = m_results.flow().data();
+    double *velocity  = m_results.velocity().data();
+    double *headloss  = m_results.headloss().data();
+    double *status    = m_results.status().data();
+    double *diameter  = m_results.diameter().data();
+    double *roughness = m_results.roughness().data();
+    double *lquality  = m_results.linkQuality().data();
     
-    double roughness;
-    err = EN_getlinkvalue(m_proj, pipe->index(), EN_ROUGHNESS, &roughness);
-    epanetError(err);
+    const double roughnessScale = (hyd->Formflag == DW) ? 1000.0 * Ucf[ELEV] : 1.0;
+    
+    for (int i = 1; i <= numLinks; ++i)
+    {
+        const Slink& link = net->Link[i];
+        
+        // closed links have zero flow, velocity and headloss
+        const double open = (hyd->LinkStatus[i] <= CLOSED) ? 0.0 : 1.0;
+        const double q = hyd->LinkFlow[i];
+        const double h = hyd->NodeHead[link.N1] - hyd->NodeHead[link.N2];
+        
+        status[i] = open;
+        flow[i]   = open * q;
+        
+        if (link.Type == PUMP)
+        {
+            velocity[i] = 0.0;
+            headloss[i] = open * h;
+            diameter[i] = 0.0;
+        }
+        else
+        {
+            velocity[i] = open * (std::fabs(q) / (PI * SQR(link.Diam) / 4.0));
+            headloss[i] = open * std::fabs(h);
+            diameter[i] = link.Diam;
+        }
+        
+        roughness[i] = (link.Type <= PIPE) ? link.Kc * roughnessScale : 0.0;
+    }
+    
+    const double ucfVelocity = Ucf[VELOCITY], ucfHeadloss = Ucf[HEADLOSS], ucfDiam = Ucf[DIAM];
+    for (int i = 1; i <= numLinks; ++i)
+    {
+        flow[i]     *= ucfFlow;
+        velocity[i] *= ucfVelocity;
+        headloss[i] *= ucfHeadloss;
+        diameter[i] *= ucfDiam;
+    }
+    
+    // link quality is only available when a water quality analysis is being run
+    if (qual->Qualflag == NONE)
+    {
+        std::fill(m_results.linkQuality().begin(), m_results.linkQuality().end(), 0.0);
+    }
+    else
+    {
+        for (int i = 1; i <= numLinks; ++i)
+            lquality[i] = avgqual(m_proj, i) * Ucf[LINKQUAL];
+    }
+}
+
+void
+HydEPANET::updateNetwork(HydPipe* pipe) const
+{
+    const int idx = pipe->index();
     
+    // diameter can be modified
+    double diameter  = m_results.diameter(idx);
+    double flow      = m_results.flow(idx);
+    double velocity  = m_results.velocity(idx);
+    double headloss  = m_results.headloss(idx);
+    double status    = m_results.status(idx);
+    double quality   = m_results.linkQuality(idx);
+    double roughness = m_results.roughness(idx);
 
     // friction_factor = #dunno how to get friction factor.... Could be //EN_SETTING....?
     // reaction_rate = #dunno how to get reaction rate....?
@@ -336,19 +645,11 @@ HydEPANET::updateNetwork(HydPipe* pipe) const
 void
 HydEPANET::updateNetwork(HydPump* pump) const
 {
-    int err;
+    const int idx = pump->index();
     
-    double flow;
-    err = EN_getlinkvalue(m_proj, pump->index(), EN_FLOW, &flow);
-    epanetError(err);
-    
-    double status;
-    err = EN_getlinkvalue(m_proj, pump->index(), EN_STATUS, &status);
-    epanetError(err);
-
-    double quality;
-    err = EN_getlinkvalue(m_proj, pump->index(), EN_QUALITY, &quality);
-    epanetError(err);
+    double flow    = m_results.flow(idx);
+    double status  = m_results.status(idx);
+    double quality = m_results.linkQuality(idx);
     
     if (m_extended)
     {
@@ -384,27 +685,13 @@ HydEPANET::updateNetwork(HydTank* tank) const
 void
 HydEPANET::updateNetwork(HydValve* valve) const
 {
-    int err;
+    const int idx = valve->index();
     
-    double flow;
-    err = EN_getlinkvalue(m_proj, valve->index(), EN_FLOW, &flow);
-    epanetError(err);
-    
-    double velocity;
-    err = EN_getlinkvalue(m_proj, valve->index(), EN_VELOCITY, &velocity);
-    epanetError(err);
-    
-    double headloss;
-    err = EN_getlinkvalue(m_proj, valve->index(), EN_HEADLOSS, &headloss);
-    epanetError(err);
-    
-    double status;
-    err = EN_getlinkvalue(m_proj, valve->index(), EN_STATUS, &status);
-    epanetError(err);
-
-    double quality;
-    err = EN_getlinkvalue(m_proj, valve->index(), EN_QUALITY, &quality);
-    epanetError(err);
+    double flow     = m_results.flow(idx);
+    double velocity = m_results.velocity(idx);
+    double headloss = m_results.headloss(idx);
+    double status   = m_results.status(idx);
+    double quality  = m_results.linkQuality(idx);
     
     if (m_extended)
     {
@@ -436,23 +723,12 @@ HydEPANET::updateNetwork(HydValve* valve) const
 void
 HydEPANET::updateNetwork(HydJunction* junction) const
 {
-    int err;
+    const int idx = junction->index();
     
-    double actual_demand;
-    err = EN_getnodevalue(m_proj, junction->index(), EN_DEMAND, &actual_demand);
-    epanetError(err);
-    
-    double total_head;
-    err = EN_getnodevalue(m_proj, junction->index(), EN_HEAD, &total_head);
-    epanetError(err);
-    
-    double pressure;
-    err = EN_getnodevalue(m_proj, junction->index(), EN_PRESSURE, &pressure);
-    epanetError(err);
-    
-    double quality;
-    err = EN_getnodevalue(m_proj, junction->index(), EN_QUALITY, &quality);
-    epanetError(err);
+    double actual_demand = m_results.demand(idx);
+    double total_head    = m_results.head(idx);
+    double pressure      = m_results.pressure(idx);
+    double quality       = m_results.nodeQuality(idx);
     
     if (m_extended)
     {
@@ -475,19 +751,11 @@ HydEPANET::updateNetwork(HydJunction* junction) const
 void
 HydEPANET::updateNetwork(HydReservoir* reservoir)  const
 {
-    int err;
-    
-    double net_inflow;
-    err = EN_getnodevalue(m_proj, reservoir->index(), EN_DEMAND, &net_inflow);
-    epanetError(err);
-    
-    double pressure;
-    err = EN_getnodevalue(m_proj, reservoir->index(), EN_PRESSURE, &pressure);
-    epanetError(err);
+    const int idx = reservoir->index();
     
-    double quality;
-    err = EN_getnodevalue(m_proj, reservoir->index(), EN_QUALITY, &quality);
-    epanetError(err);
+    double net_inflow = m_results.demand(idx);
+    double pressure   = m_results.pressure(idx);
+    double quality    = m_results.nodeQuality(idx);
     
     if (m_extended)
     {
@@ -512,6 +780,12 @@ HydEPANET::updateNetwork( int scenario_index ) const
     if (!m_hydNet)
         return; 
     
+    extractResults();
+    
+    // only grows the result arrays if controls or tanks have added intermediate time steps
+    if (m_extended)
+        m_hydNet->reserveTimePoints(scenario_index + 1);
+    
     const std::vector<HydPipe*>& pipes = m_hydNet->pipes();
     for (auto i = pipes.begin(); i != pipes.end(); ++i)
         updateNetwork(*i);
@@ -536,13 +810,23 @@ HydEPANET::updateNetwork( int scenario_index ) const
     for (auto i = valves.begin(); i != valves.end(); ++i)
         updateNetwork(*i);
     
-    double c = HydObjective::cost(m_hydNet) / 1E6;                      // cost in millions
-    double h = HydObjective::headDeficit(m_hydNet, scenario_index);     // calls junction->setHeadDeficit(deficit);
-    double r = HydObjective::resilience(m_hydNet, scenario_index);
+    // the objectives are calculated for all time points at the end of the run - see updateObjectives()
+}
+
+void
+HydEPANET::updateObjectives( void ) const
+{
+    // one pass over the junction time series for each objective
+    std::vector<HydFloat> head_deficit;
+    m_deficitBounded = !HydObjective::headDeficit(m_hydNet, head_deficit, m_deficitBound);   // sets the junction head deficits
     
-    if (m_extended)
-        m_hydNet->addObjectives(c, h, r);
-    else m_hydNet->setObjectives(c, h, r);
+    std::vector<HydFloat> resilience;
+    HydObjective::resilience(m_hydNet, resilience);
+    
+    // diameters do not change during a run so the cost is the same at every time point
+    std::vector<HydFloat> cost(head_deficit.size(), HydObjective::cost(m_hydNet) / 1E6);  // cost in millions
+    
+    m_hydNet->setObjectives(cost, head_deficit, resilience);
 }
 
 void
@@ -42,6 +42,14 @@
 #include "HydNetwork.h"
 #endif
 
+#ifndef __HYDRESULTS_H__
+#include "HydResults.h"
+#endif
+
+#ifndef __HYDRUNMETRICS_H__
+#include "HydRunMetrics.h"
+#endif
+
 #ifndef __LOGGER_H__
 #include "ALogger.h"
 #endif
@@ -49,6 +57,8 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <functional>
+#include <limits>
 
 
 // defined in EPANET types.h
@@ -65,13 +75,100 @@ public:
     // load a new EPANET network and construct a HydNetwork - caller owns HydNetwork memory
     // subsequent calls will generate a new 'current' HydNetwork
     // only the current HydNetwork will be updated - see run() below
+    // the file is read into memory and parsed by load(name, text) - no report file is written unless the network has errors
     HydNetwork*
     load( const std::string& name );
     
+    // load a network from the text of an EPANET .inp file held in memory - no files are read or written
+    // name is only used for messages and fileName()
+    HydNetwork*
+    load( const std::string& name, const std::string& text );
+    
+    HydNetwork*
+    load( const std::string& name, const char* text, long size );
+    
+    // read the contents of a network file for load(name, text) - returns false if the file cannot be read
+    static bool
+    readFile( const std::string& name, std::string& text );
+    
     // this will update the current HydNetwork
     void
     run(void) const;
     
+    // warm start - as run() but the solver starts from the given link flows rather than initial flow estimates
+    // seedFlows is usually the initialFlows() of a similar (parent) solution and is indexed by EPANET link index
+    void
+    run( const std::vector<double>& seedFlows ) const;
+    
+    // look ahead - run the simulation once for each diameter of link link_idx, all other decisions unchanged
+    // result(i) is called after the run for diameters[i] while the current HydNetwork holds that run's values
+    // the sweep starts at diameters[start] and moves outward so each run is warm started from the flows of
+    // a neighbouring diameter; the link's original diameter is restored afterwards
+    void
+    sweepDiameter( int link_idx, const std::vector<HydFloat>& diameters, int start, const std::function<void(int)>& result ) const;
+    
+    // the converged link flows at the first time step of the last run() (EPANET internal units)
+    const std::vector<double>&
+    initialFlows( void ) const { return m_initialFlows; }
+    
+    // the number of solver iterations, summed over all time steps, taken by the last run()
+    int
+    iterations( void ) const { return m_iterations; }
+    
+    // totals over all calls to run() since load() - warm is true for runs started from seed flows
+    long
+    totalRuns( bool warm ) const { return m_totalRuns[warm]; }
+    
+    long
+    totalIterations( bool warm ) const { return m_totalIterations[warm]; }
+    
+    // solver telemetry for the last run() - iterations per time step, wall times and EPANET warnings
+    const HydRunMetrics&
+    runMetrics( void ) const { return m_runMetrics; }
+    
+    // the telemetry of all calls to run() since load() aggregated into histograms
+    const HydRunHistogram&
+    runHistogram( void ) const { return m_runHistogram; }
+    
+    // persistent hydraulics - the EPANET hydraulic solver is opened once per load() and kept open
+    // so the node ordering and sparse matrix structures are not rebuilt on every run() (default true)
+    void
+    setPersistentHydraulics( bool persistent );
+    
+    bool
+    persistentHydraulics( void ) const { return m_persistent; }
+    
+    // use EPANET's supernodal Cholesky solver rather than the column-by-column solver (default false)
+    // the heads agree to within rounding error - the supernodal solver is faster for large networks
+    void
+    setSupernodalSolver( bool supernodal );
+    
+    bool
+    supernodalSolver( void ) const { return m_supernodal; }
+    
+    // compute the Hazen-Williams head loss coefficients of all pipes at once with an approximate pow() rather than
+    // libm pow() (default false) - faster where the loop vectorises (AVX2, NEON), the heads agree to within rounding error
+    void
+    setApproxHWPow( bool approx );
+    
+    bool
+    approxHWPow( void ) const { return m_approxPow; }
+    
+    // stop calculating the head deficit of a run() once it exceeds bound at some time point (default no bound)
+    // the solution can then be rejected - HydNetwork::headDeficit() holds partial totals, the largest of which exceeds bound
+    // and the junction head deficits are incomplete. For callers that only need to reject, e.g. a feasibility filter:
+    // HOWSEvaluator never sets a bound, since SSHH's archive and acceptance, the evaluation cache and the HDH/KBH 
+    // heuristics (which read the junction deficits) all need the complete values
+    void
+    setHeadDeficitBound( HydFloat bound ) { m_deficitBound = bound; }
+    
+    void
+    clearHeadDeficitBound( void ) { m_deficitBound = std::numeric_limits<HydFloat>::max(); }
+    
+    // true if the head deficit of the last run() exceeded the bound and is incomplete
+    bool
+    headDeficitBounded( void ) const { return m_deficitBounded; }
+    
     // the current HydNetwork 
     HydNetwork* 
     getHydNet( void ) const { return m_hydNet; }
@@ -80,6 +177,14 @@ public:
     Project* 
     getProject( void ) const  { return m_proj; }
     
+    // the name of the current network file
+    const std::string&
+    fileName( void ) const { return m_fileName; }
+    
+    // the results for the most recent time step of run() - all nodes and links in user units
+    const HydResults&
+    results( void ) const { return m_results; }
+    
 
     // direct access to EPANET node data
     double 
@@ -116,6 +221,16 @@ private:
     bool
     epanetError( int error_code ) const;
     
+    void
+    runSimulation( const std::vector<double>* seedFlows ) const;
+    
+    /// open/close the EPANET hydraulic solver
+    void
+    openHydraulics( void ) const;
+    
+    void
+    closeHydraulics( void ) const;
+    
     /// buld a HydNetwork from the .inp definition loaded in EPANET project
     void 
     buildNetwork( void );
@@ -139,6 +254,10 @@ private:
     addValve(int index, const std::string& hid );
     ///
     
+    /// copy the current time step's results for all nodes and links into m_results
+    void
+    extractResults( void ) const;
+    
     /// update/add EPANET dynamic values to HydNetwork
     void
     updateNetwork( int scenIdx ) const;
@@ -160,12 +279,30 @@ private:
     
     void
     updateNetwork(HydReservoir* reservoir) const;
+    
+    /// calculate the objectives for all time points of a run
+    void
+    updateObjectives( void ) const;
     ///
 
     Project    *m_proj;
     HydNetwork *m_hydNet;
     int m_epanetOpen;
+    mutable int m_hydOpen;
+    bool m_persistent;
+    bool m_supernodal;
+    bool m_approxPow;
     bool m_extended;
+    std::string m_fileName;
+    HydFloat m_deficitBound;
+    mutable bool m_deficitBounded;
+    mutable HydResults m_results;
+    mutable std::vector<double> m_initialFlows;
+    mutable int  m_iterations;
+    mutable long m_totalRuns[2];
+    mutable long m_totalIterations[2];
+    mutable HydRunMetrics   m_runMetrics;
+    mutable HydRunHistogram m_runHistogram;
     mutable Logger m_logger;
 };
 
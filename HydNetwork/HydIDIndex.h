@@ -0,0 +1,131 @@
+/* HydIDIndex 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$
+ $   HydIDIndex.h   $
+ $$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ Maps component IDs to integer handles (HydNetComp::pos()) - see HydNetwork::findLink() and HydNetwork::findNode()
+
+ A flat open addressing hash table with linear probing. The IDs are interned, in insertion order, next to
+ their hash values and handles, and the table only holds an entry number for each slot, so a lookup
+ touches one or two cache lines and compares the full 64 bit hash before comparing any strings.
+ The table is kept at most half full and is rebuilt from the stored hashes when it grows.
+
+*/
+
+
+#ifndef __HYDIDINDEX_H__
+#define __HYDIDINDEX_H__
+
+#include <cstdint>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+class HydIDIndex
+{
+public:
+
+    HydIDIndex( void ) : m_mask(0), m_slots(), m_hashes(), m_handles(), m_ids() {}
+    ~HydIDIndex( void )=default;
+
+    void
+    clear( void )
+    {
+        m_mask = 0;
+        m_slots.clear();
+        m_hashes.clear();
+        m_handles.clear();
+        m_ids.clear();
+    }
+
+    int
+    size( void ) const { return (int) m_ids.size(); }
+
+    // returns false (and leaves the index unchanged) if the ID is already present
+    bool
+    insert( const std::string& hid, int handle )
+    {
+        if (2 * (m_ids.size() + 1) > m_slots.size())
+            rehash(std::max<size_t>(16, 2 * m_slots.size()));
+
+        const uint64_t h = hash(hid);
+        size_t s = h & m_mask;
+        for (; m_slots[s] != 0; s = (s + 1) & m_mask)
+        {
+            const int e = m_slots[s] - 1;
+            if (m_hashes[e] == h && m_ids[e] == hid)
+                return false;
+        }
+
+        m_slots[s] = (int) m_ids.size() + 1;
+        m_hashes.push_back(h);
+        m_handles.push_back(handle);
+        m_ids.push_back(hid);
+        return true;
+    }
+
+    // the handle of the ID or -1 if it is not present
+    int
+    find( const std::string& hid ) const
+    {
+        if (m_ids.empty())
+            return -1;
+
+        const uint64_t h = hash(hid);
+        for (size_t s = h & m_mask; m_slots[s] != 0; s = (s + 1) & m_mask)
+        {
+            const int e = m_slots[s] - 1;
+            if (m_hashes[e] == h && m_ids[e] == hid)
+                return m_handles[e];
+        }
+        return -1;
+    }
+
+    // 64 bit FNV-1a
+    static uint64_t
+    hash( const std::string& hid )
+    {
+        uint64_t h = 14695981039346656037ULL;
+        for (size_t i = 0; i < hid.size(); ++i)
+        {
+            h ^= (unsigned char) hid[i];
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+private:
+
+    // numSlots is a power of 2
+    void
+    rehash( size_t numSlots )
+    {
+        m_slots.assign(numSlots, 0);
+        m_mask = numSlots - 1;
+
+        for (size_t e = 0; e < m_hashes.size(); ++e)
+        {
+            size_t s = m_hashes[e] & m_mask;
+            while (m_slots[s] != 0)
+                s = (s + 1) & m_mask;
+            m_slots[s] = (int) e + 1;
+        }
+    }
+
+    size_t m_mask;
+
+    std::vector<int>         m_slots;       /// entry number + 1, 0 for an empty slot
+    std::vector<uint64_t>    m_hashes;      /// by entry
+    std::vector<int>         m_handles;     /// by entry
+    std::vector<std::string> m_ids;         /// by entry
+};
+
+#endif
+
+
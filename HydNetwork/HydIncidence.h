@@ -0,0 +1,145 @@
+/* HydIncidence 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$$
+ $   HydIncidence.h   $
+ $$$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ The node-link incidence of a HydNetwork in compressed sparse row form - see HydNetwork::buildIncidence()
+
+ Components are identified by their handle (HydNetComp::pos()). The links incident on node n are
+ links()[offset[n]],...,links()[offset[n+1] - 1], in the order the links were added to the network,
+ and the node at the other end of each of these links is held at the same position in a parallel array,
+ so both links(n) and neighbours(n) are O(degree) and return a Span into the table (no allocation).
+ A link whose two ends are the same node is listed once. Links have an empty row.
+
+*/
+
+
+#ifndef __HYDINCIDENCE_H__
+#define __HYDINCIDENCE_H__
+
+#include <vector>
+#include <cassert>
+
+
+class HydIncidence
+{
+public:
+
+    // a read only range of component handles
+    class Span
+    {
+    public:
+
+        Span( const int* first, const int* last ) : m_first(first), m_last(last) {}
+
+        const int* begin( void ) const { return m_first; }
+        const int* end( void ) const { return m_last; }
+
+        int size( void ) const { return (int) (m_last - m_first); }
+        bool empty( void ) const { return m_first == m_last; }
+
+        int operator[]( int i ) const { assert(i < size()); return m_first[i]; }
+
+    private:
+
+        const int* m_first;
+        const int* m_last;
+    };
+
+    HydIncidence( void ) : m_offset(), m_links(), m_nodes(), m_from(), m_to() {}
+    ~HydIncidence( void )=default;
+
+    void
+    clear( void )
+    {
+        m_offset.clear();
+        m_links.clear();
+        m_nodes.clear();
+        m_from.clear();
+        m_to.clear();
+    }
+
+    // the number of components the table was built for
+    int
+    size( void ) const { return m_offset.empty() ? 0 : (int) m_offset.size() - 1; }
+
+    // numComponents handles, link handles[i] joins node handles from[i] and to[i] (-1 if the node is missing)
+    void
+    build( int numComponents, const std::vector<int>& links, const std::vector<int>& from, const std::vector<int>& to )
+    {
+        assert(links.size() == from.size() && links.size() == to.size());
+
+        m_from.assign(numComponents, -1);
+        m_to.assign(numComponents, -1);
+        m_offset.assign(numComponents + 1, 0);
+
+        // count the degree of each node
+        for (int i = 0; i < links.size(); ++i)
+        {
+            m_from[links[i]] = from[i];
+            m_to[links[i]] = to[i];
+
+            if (from[i] >= 0)
+                ++m_offset[from[i] + 1];
+            if (to[i] >= 0 && to[i] != from[i])
+                ++m_offset[to[i] + 1];
+        }
+
+        for (int n = 0; n < numComponents; ++n)
+            m_offset[n + 1] += m_offset[n];
+
+        // fill each row in link order
+        m_links.assign(m_offset[numComponents], -1);
+        m_nodes.assign(m_offset[numComponents], -1);
+
+        std::vector<int> next(m_offset.begin(), m_offset.end() - 1);
+        for (int i = 0; i < links.size(); ++i)
+        {
+            if (from[i] >= 0)
+            {
+                m_links[next[from[i]]] = links[i];
+                m_nodes[next[from[i]]++] = to[i];
+            }
+            if (to[i] >= 0 && to[i] != from[i])
+            {
+                m_links[next[to[i]]] = links[i];
+                m_nodes[next[to[i]]++] = from[i];
+            }
+        }
+    }
+
+    // the links incident on the node with handle node_pos
+    Span
+    links( int node_pos ) const { return Span(m_links.data() + m_offset[node_pos], m_links.data() + m_offset[node_pos + 1]); }
+
+    // the nodes at the other end of links(node_pos)
+    Span
+    neighbours( int node_pos ) const { return Span(m_nodes.data() + m_offset[node_pos], m_nodes.data() + m_offset[node_pos + 1]); }
+
+    int
+    degree( int node_pos ) const { return m_offset[node_pos + 1] - m_offset[node_pos]; }
+
+    // the end nodes of the link with handle link_pos
+    int
+    fromNode( int link_pos ) const { return m_from[link_pos]; }
+
+    int
+    toNode( int link_pos ) const { return m_to[link_pos]; }
+
+private:
+
+    std::vector<int> m_offset;      /// by node handle, numComponents + 1 entries
+    std::vector<int> m_links;       /// incident link handles, by row
+    std::vector<int> m_nodes;       /// the node at the other end of m_links[i]
+    std::vector<int> m_from;        /// by link handle
+    std::vector<int> m_to;          /// by link handle
+};
+
+#endif
+
+
@@ -68,8 +68,8 @@ public:
     const std::string& toNodeID(void) const { return m_sToNode; }
     void setToNodeID(const std::string& to_node)  { m_sToNode = to_node; }
 
-    const std::vector<HydFloat>& flow(void) const { return m_flow; }
-    void setFlow(HydFloat flow) { m_flow = std::vector<HydFloat>(1,flow); }
+    const HydSeries<HydFloat>& flow(void) const { return m_flow; }
+    void setFlow(HydFloat flow) { m_flow.assign(1,flow); }
     void addFlow(HydFloat flow) { m_flow.push_back(flow); }
     void setFlow(const std::vector<HydFloat> &flow) { m_flow = flow; }
     
@@ -86,9 +86,9 @@ public:
         return std::fabs(*std::min_element(m_flow.begin(), m_flow.end(), comp));
     }
     
-    const std::vector<LinkStatusOption>& status(void) const { return m_status; }
+    const HydSeries<LinkStatusOption>& status(void) const { return m_status; }
     void addStatus(LinkStatusOption status) { m_status.push_back(status); }
-    void setStatus(LinkStatusOption status) { m_status = std::vector<LinkStatusOption>(1,status); }
+    void setStatus(LinkStatusOption status) { m_status.assign(1,status); }
     void setStatus(const std::vector<LinkStatusOption> & status) { m_status = status; }
 
     const std::vector<HydVertex>& coords(void) const { return m_vHydVertexs; }
@@ -97,6 +97,13 @@ public:
     void addCoords(HydVertex& c) { m_vHydVertexs.push_back(c); }
     void setCoords(const std::vector<HydVertex>& cl) { m_vHydVertexs = cl; }
 
+    void
+    bindSeries(HydTimeSeries& series, int slot) override
+    {
+        series.bind(m_quality, series.linkQuality(), slot);
+        series.bind(m_flow, series.flow(), slot);
+        series.bind(m_status, slot);
+    }
     
 protected:
     
@@ -106,8 +113,8 @@ protected:
 	std::string m_sFromNode;
 	std::string m_sToNode;
 
-	std::vector<HydFloat> m_flow;
-	std::vector<LinkStatusOption> m_status;
+	HydSeries<HydFloat> m_flow;
+	HydSeries<LinkStatusOption> m_status;
 
 	std::vector<HydVertex> m_vHydVertexs;
 };
@@ -30,6 +30,10 @@
 #include "HydTypes.h" 
 #endif
 
+#ifndef __HYDTIMESERIES_H__
+#include "HydTimeSeries.h" 
+#endif
+
 class HydNetComp
 {
 public:
@@ -75,9 +79,9 @@ public:
     const std::string& group(void) const { return m_group; }
     void setGroup(const std::string& g) { m_group = g; }
 	
-    const std::vector<HydFloat>& quality(void) const { return m_quality; }
+    const HydSeries<HydFloat>& quality(void) const { return m_quality; }
     void addQuality(HydFloat quality) { m_quality.push_back(quality); }
-    void setQuality(HydFloat quality) { m_quality = std::vector<HydFloat>(1,quality); }
+    void setQuality(HydFloat quality) { m_quality.assign(1,quality); }
     void setQuality(const std::vector<HydFloat> & quality) { m_quality = quality; }
 
     bool isDecisionVariable(void) const { return m_isDecisionVariable; }
@@ -85,6 +89,10 @@ public:
 
     virtual void clear(void)=0;
     
+    // store the time series of simulation results in slot of the HydNetwork's arrays - see HydTimeSeries.h
+    // slot is the position of the component in HydNetwork::links() or HydNetwork::nodes()
+    virtual void bindSeries(HydTimeSeries& series, int slot)=0;
+    
 protected:
     	
     int m_pos;
@@ -94,7 +102,7 @@ protected:
 	std::string m_sDescription;
 	std::string m_sTag;
     std::string m_group;
-    std::vector<HydFloat> m_quality;
+    HydSeries<HydFloat> m_quality;
     bool m_isDecisionVariable;
 	
 };
@@ -27,6 +27,7 @@
 
 #include <cmath>
 #include <cstdlib> // for std::rand
+#include <algorithm>
 
 HydNetwork::HydNetwork(void)
 {
@@ -78,6 +79,25 @@ HydNetwork::clear(void)
         m_vComponents[i]->clear();
 }
 
+void
+HydNetwork::reserveTimePoints(int numTimePoints)
+{
+    if (numTimePoints <= m_series.timePoints() && m_series.numLinks() == m_vLinks.size() && m_series.numNodes() == m_vNodes.size())
+        return;
+    
+    // the components copy their values from the old arrays as they are bound to the new ones
+    HydTimeSeries series;
+    series.resize((int) m_vNodes.size(), (int) m_vLinks.size(), std::max(numTimePoints, 2 * m_series.timePoints()));
+    
+    for (int i = 0; i < m_vLinks.size(); ++i)
+        m_vLinks[i]->bindSeries(series, i);
+    
+    for (int i = 0; i < m_vNodes.size(); ++i)
+        m_vNodes[i]->bindSeries(series, i);
+    
+    m_series.swap(series);
+}
+
 bool 
 HydNetwork::addComponent(HydNetComp* comp)
 {
@@ -90,42 +110,45 @@ HydNetwork::addComponent(HydNetComp* comp)
     comp->setPos((int) m_vComponents.size());
     m_vComponents.push_back(comp);
     
+    // the incidence table is out of date until buildIncidence() is called
+    m_incidence.clear();
+    
     // networks consist mainly of pipes and junctions so they get checked first
     switch(comp->hydType())
     {
         case HydType::Pipe:      
             m_vPipes.push_back(static_cast<HydPipe*>(comp));
-            m_pipeIndex[comp->ID()] = static_cast<HydPipe*>(comp);
+            m_linkIndex.insert(comp->ID(), comp->pos());
             m_vLinks.push_back(static_cast<HydPipe*>(comp));
             return true;      
             break;
         case HydType::Junction:  
             m_vJunctions.push_back(static_cast<HydJunction*>(comp));
-            m_junctionIndex[comp->ID()] = static_cast<HydJunction*>(comp);
+            m_nodeIndex.insert(comp->ID(), comp->pos());
             m_vNodes.push_back(static_cast<HydJunction*>(comp));
             return true;
             break;
         case HydType::Pump:      
             m_vPumps.push_back(static_cast<HydPump*>(comp));
-            m_pumpIndex[comp->ID()] = static_cast<HydPump*>(comp);
+            m_linkIndex.insert(comp->ID(), comp->pos());
             m_vLinks.push_back(static_cast<HydPump*>(comp));
             return true;     
             break;
         case HydType::Valve:     
             m_vValves.push_back(static_cast<HydValve*>(comp));
-            m_valveIndex[comp->ID()] = static_cast<HydValve*>(comp);
+            m_linkIndex.insert(comp->ID(), comp->pos());
             m_vLinks.push_back(static_cast<HydValve*>(comp));
             return true;     
             break;
         case HydType::Tank:      
             m_vTanks.push_back(static_cast<HydTank*>(comp));
-            m_tankIndex[comp->ID()] = static_cast<HydTank*>(comp);
+            m_nodeIndex.insert(comp->ID(), comp->pos());
             m_vNodes.push_back(static_cast<HydTank*>(comp));
             return true;      
             break;
         case HydType::Reservoir: 
             m_vReservoirs.push_back(static_cast<HydReservoir*>(comp));
-            m_reservoirIndex[comp->ID()] = static_cast<HydReservoir*>(comp);
+            m_nodeIndex.insert(comp->ID(), comp->pos());
             m_vNodes.push_back(static_cast<HydReservoir*>(comp));
             return true; 
             break;
@@ -145,12 +168,12 @@ HydNetwork::findComponent(const std::string& comp_id, HydType comp_type) const
     // networks consist mainly of pipes and junctions so they get checked first
     switch(comp_type)
     {
-        case HydType::Pipe:      return find(comp_id, m_pipeIndex);      break;
-        case HydType::Junction:  return find(comp_id, m_junctionIndex);  break;
-        case HydType::Pump:      return find(comp_id, m_pumpIndex);      break;
-        case HydType::Valve:     return find(comp_id, m_valveIndex);     break;
-        case HydType::Tank:      return find(comp_id, m_tankIndex);      break;
-        case HydType::Reservoir: return find(comp_id, m_reservoirIndex); break;
+        case HydType::Pipe:      return findPipe(comp_id);      break;
+        case HydType::Junction:  return findJunction(comp_id);  break;
+        case HydType::Pump:      return findPump(comp_id);      break;
+        case HydType::Valve:     return findValve(comp_id);     break;
+        case HydType::Tank:      return findTank(comp_id);      break;
+        case HydType::Reservoir: return findReservoir(comp_id); break;
 
         default:
             std::cout << "HydNetwork::findComponent - error unknown HydType" << std::endl;
@@ -162,39 +185,117 @@ HydNetwork::findComponent(const std::string& comp_id, HydType comp_type) const
     return nullptr;
 }
 
-HydNode* 
-HydNetwork::findNode(const std::string& node_id) const
+void
+HydNetwork::buildIncidence( void )
 {
-    HydNetComp *comp = nullptr;
+    std::vector<int> links(m_vLinks.size());
+    std::vector<int> from(m_vLinks.size());
+    std::vector<int> to(m_vLinks.size());
     
-    if ((comp = findComponent(node_id, HydType::Junction)) == nullptr) 
-        if ((comp = findComponent(node_id, HydType::Reservoir)) == nullptr)  
-            if ((comp = findComponent(node_id, HydType::Tank)) == nullptr)
-                return nullptr;
-
-    return static_cast<HydNode*>(comp);
+    for (int i = 0; i < m_vLinks.size(); ++i)
+    {
+        links[i] = m_vLinks[i]->pos();
+        from[i]  = nodePos(m_vLinks[i]->fromNodeID());
+        to[i]    = nodePos(m_vLinks[i]->toNodeID());
+    }
+    
+    m_incidence.build((int) m_vComponents.size(), links, from, to);
+    
+    // the diameter uniformity cache is rebuilt by the next call to diameterUniformity()
+    m_uniformity.clear();
 }
 
-HydLink* 
-HydNetwork::findLink(const std::string& link_id) const
+const std::vector<HydFloat>&
+HydNetwork::diameterUniformity( void )
 {
-    HydNetComp *comp = nullptr;
+    std::vector<int> changed;
     
-    if ((comp = findComponent(link_id, HydType::Pipe)) == nullptr) 
-        if ((comp = findComponent(link_id, HydType::Pump)) == nullptr)  
-            if ((comp = findComponent(link_id, HydType::Valve)) == nullptr)
-                return nullptr;
-
-    return static_cast<HydLink*>(comp);
+    if (m_uniformity.size() != m_vJunctions.size() || m_uniformityDiameter.size() != m_vPipes.size())
+    {
+        m_uniformity.assign(m_vJunctions.size(), 0.0);
+        m_uniformityStale.assign(m_vJunctions.size(), 1);
+        m_uniformityDiameter.resize(m_vPipes.size());
+        
+        m_junctionSlot.assign(m_vComponents.size(), -1);
+        for (int j = 0; j < m_vJunctions.size(); ++j)
+        {
+            m_junctionSlot[m_vJunctions[j]->pos()] = j;
+            changed.push_back(j);
+        }
+        
+        for (int i = 0; i < m_vPipes.size(); ++i)
+            m_uniformityDiameter[i] = m_vPipes[i]->diameter();
+    }
+    else
+    {
+        // O(P) - compare each pipe with the diameter last used and mark the junctions at its ends
+        for (int i = 0; i < m_vPipes.size(); ++i)
+        {
+            HydFloat diameter = m_vPipes[i]->diameter();
+            if (diameter == m_uniformityDiameter[i])
+                continue;
+            
+            m_uniformityDiameter[i] = diameter;
+            
+            int link_pos = m_vPipes[i]->pos();
+            int ends[2] = { fromNodePos(link_pos), toNodePos(link_pos) };
+            for (int e = 0; e < 2; ++e)
+            {
+                int j = (ends[e] >= 0) ? m_junctionSlot[ends[e]] : -1;
+                if (j >= 0 && !m_uniformityStale[j])
+                {
+                    m_uniformityStale[j] = 1;
+                    changed.push_back(j);
+                }
+            }
+        }
+    }
+    
+    // sum / (n * max) of the diameters of the pipes connected to each changed junction
+    for (int j : changed)
+    {
+        int      num_pipes = 0;
+        HydFloat sum = 0.0;
+        HydFloat max = 0.0;
+        
+        for (int link_pos : linksToNode(m_vJunctions[j]->pos()))
+        {
+            const HydPipe* pipe = getPipe(link_pos);
+            if (pipe)
+            {
+                sum += pipe->diameter();
+                max = (num_pipes == 0) ? pipe->diameter() : std::max(max, pipe->diameter());
+                ++num_pipes;
+            }
+        }
+        
+        if (num_pipes > 0)
+            m_uniformity[j] = sum / (num_pipes * max);
+        else 
+        {
+            m_uniformity[j] = 0.0;
+            std::cout << "ERROR orphan junction" << std::endl;
+        }
+        
+        m_uniformityStale[j] = 0;
+    }
+    
+    return m_uniformity;
 }
 
 std::vector<HydLink*>
 HydNetwork::findLinksToNode(const std::string& node_id) const
 {
     std::vector<HydLink*> links;
-    for (int i = 0; i < m_vLinks.size(); ++i)
-        if (m_vLinks[i]->toNodeID() == node_id || m_vLinks[i]->fromNodeID() == node_id)
-            links.push_back( m_vLinks[i] );
+    
+    int node_pos = nodePos(node_id);
+    if (node_pos < 0)
+        return links;
+    
+    HydIncidence::Span span = linksToNode(node_pos);
+    links.reserve(span.size());
+    for (int link_pos : span)
+        links.push_back( getLink(link_pos) );
 
     return links;
 }
@@ -203,12 +304,16 @@ std::vector<HydNode*>
 HydNetwork::findNeighboursForNode(const std::string& node_id) const
 {
     std::vector<HydNode*> nodes;
-    std::vector<HydLink*> links = findLinksToNode(node_id);
-    for (int j = 0; j < links.size(); ++j)
-    {
-        std::string nodeID = (links[j]->toNodeID() == node_id) ? links[j]->fromNodeID() : links[j]->toNodeID(); 
-        nodes.push_back(findNode(nodeID)); 
-    }
+    
+    int node_pos = nodePos(node_id);
+    if (node_pos < 0)
+        return nodes;
+    
+    HydIncidence::Span span = neighboursForNode(node_pos);
+    nodes.reserve(span.size());
+    for (int neighbour_pos : span)
+        nodes.push_back( getNode(neighbour_pos) );
+    
     return nodes;
 }
     
@@ -80,6 +80,14 @@
 #include "HydLookAhead.h"
 #endif
 
+#ifndef __HYDIDINDEX_H__
+#include "HydIDIndex.h"
+#endif
+
+#ifndef __HYDINCIDENCE_H__
+#include "HydIncidence.h"
+#endif
+
 #include <map>
 
 class HydNetwork
@@ -100,34 +108,63 @@ public:
     addComponent(HydNetComp* component);
     
     HydNetComp*
-    getComponent(int pos) { return m_vComponents[pos]; }
+    getComponent(int pos) const { return m_vComponents[pos]; }
 
+    //
+    // integer handles - resolve an ID once with linkPos()/nodePos() and use the handle (HydNetComp::pos()) afterwards
+    // link and node IDs are separate name spaces (as in EPANET) so a node and a link can share an ID
+    //
+    
+    // the handle of a link/node or -1 if there is no such component
+    int
+    linkPos(const std::string& link_id) const { return m_linkIndex.find(link_id); }
+    
+    int
+    nodePos(const std::string& node_id) const { return m_nodeIndex.find(node_id); }
+    
+    // the component with handle pos, or nullptr if pos is -1 or the component is of another type
+    HydLink*
+    getLink(int pos) const { return (pos >= 0 && isLink(m_vComponents[pos]->hydType())) ? static_cast<HydLink*>(m_vComponents[pos]) : nullptr; }
+    
+    HydNode*
+    getNode(int pos) const { return (pos >= 0 && !isLink(m_vComponents[pos]->hydType())) ? static_cast<HydNode*>(m_vComponents[pos]) : nullptr; }
+    
+    HydPipe*
+    getPipe(int pos) const { return get<HydPipe>(pos, HydType::Pipe); }
+    
+    HydJunction*
+    getJunction(int pos) const { return get<HydJunction>(pos, HydType::Junction); }
+    
+    //
+    // find by ID - one hash table probe
+    //
+    
     HydNetComp* 
     findComponent(const std::string& comp_id, HydType type) const;
 
 	HydNode* 
-    findNode(const std::string& node_id) const;
+    findNode(const std::string& node_id) const { return getNode(nodePos(node_id)); }
     
     HydLink* 
-    findLink(const std::string& link_id) const;
+    findLink(const std::string& link_id) const { return getLink(linkPos(link_id)); }
     
     HydPipe* 
-    findPipe(const std::string& pipe_id) const { return find(pipe_id, m_pipeIndex); }
+    findPipe(const std::string& pipe_id) const { return get<HydPipe>(linkPos(pipe_id), HydType::Pipe); }
     
     HydJunction* 
-    findJunction(const std::string& junction_id) const { return find(junction_id, m_junctionIndex); }
+    findJunction(const std::string& junction_id) const { return get<HydJunction>(nodePos(junction_id), HydType::Junction); }
     
     HydPump* 
-    findPump(const std::string& pump_id) const { return find(pump_id, m_pumpIndex); }
+    findPump(const std::string& pump_id) const { return get<HydPump>(linkPos(pump_id), HydType::Pump); }
     
     HydValve* 
-    findValve(const std::string& valve_id) const { return find(valve_id, m_valveIndex); }
+    findValve(const std::string& valve_id) const { return get<HydValve>(linkPos(valve_id), HydType::Valve); }
     
     HydReservoir* 
-    findReservoir(const std::string& res_id) const { return find(res_id, m_reservoirIndex); }
+    findReservoir(const std::string& res_id) const { return get<HydReservoir>(nodePos(res_id), HydType::Reservoir); }
     
     HydTank* 
-    findTank(const std::string& tank_id) const { return find(tank_id, m_tankIndex); }
+    findTank(const std::string& tank_id) const { return get<HydTank>(nodePos(tank_id), HydType::Tank); }
     
     std::vector<HydLink*>
     findLinksToNode(const std::string& node_id) const;
@@ -135,6 +172,32 @@ public:
     std::vector<HydNode*>
     findNeighboursForNode(const std::string& node_id) const;
     
+    //
+    // topology by handle - O(degree) and no allocation, see HydIncidence
+    //
+    
+    // (re)build the node-link incidence table - call once all the components have been added
+    void
+    buildIncidence( void );
+    
+    const HydIncidence&
+    incidence( void ) const { assert(m_incidence.size() == m_vComponents.size()); return m_incidence; }
+    
+    // the handles of the links incident on a node
+    HydIncidence::Span
+    linksToNode( int node_pos ) const { return incidence().links(node_pos); }
+    
+    // the handles of the nodes at the other end of linksToNode(node_pos)
+    HydIncidence::Span
+    neighboursForNode( int node_pos ) const { return incidence().neighbours(node_pos); }
+    
+    // the handles of the end nodes of a link, -1 if the node is missing
+    int
+    fromNodePos( int link_pos ) const { return incidence().fromNode(link_pos); }
+    
+    int
+    toNodePos( int link_pos ) const { return incidence().toNode(link_pos); }
+    
 	const std::vector<HydPipe*>& 
     pipes(void) const { return m_vPipes; }
     
@@ -153,6 +216,12 @@ public:
     const std::vector<HydTank*>& 
     tanks(void) const { return m_vTanks; }
 
+    const std::vector<HydLink*>& 
+    links(void) const { return m_vLinks; }
+    
+    const std::vector<HydNode*>& 
+    nodes(void) const { return m_vNodes; }
+
     // hydraulic options
     HydHydraulicOptions*
     hydraulicOptions(void) const { return m_hydraulicOptions; }
@@ -161,6 +230,18 @@ public:
     // other scalar network variables (i.e pipe diameters, lengths etc) are not affected
     void
     clear(void);
+    
+    //
+    // simulation results - the time series of each component are held in contiguous arrays
+    //
+    
+    // make room for numTimePoints values in the time series of every component
+    // the arrays only grow (at least doubling) and existing values are kept - see HydTimeSeries.h
+    void
+    reserveTimePoints(int numTimePoints);
+    
+    const HydTimeSeries&
+    series(void) const { return m_series; }
 
     //
     // decision variable options - i.e pipe diameters for pipe decision variables
@@ -238,6 +319,8 @@ public:
     void addObjectives(HydFloat cost, HydFloat headDeficit);
     void addObjectives(HydFloat cost, HydFloat headDeficit, HydFloat resilience);
     
+    void setResilience(const std::vector<HydFloat>& resilience) { m_resilience = resilience; }
+    
     HydFloat cost(int scenIdx) const { return m_cost[scenIdx]; }
     HydFloat headDeficit(int scenIdx) const { return m_headDeficit[scenIdx]; }
     HydFloat resilience(int scenIdx) const { return m_resilience[scenIdx]; }
@@ -245,6 +328,11 @@ public:
     const std::vector<HydFloat>& cost(void) const { return m_cost; }
     const std::vector<HydFloat>& headDeficit(void) const { return m_headDeficit; }
     const std::vector<HydFloat>& resilience(void) const { return m_resilience; }
+    
+    // the diameter uniformity of each junction (by position in junctions()) - see HydObjective::resilience()
+    // only the junctions at the ends of pipes whose diameter has changed since the last call are recalculated
+    const std::vector<HydFloat>&
+    diameterUniformity( void );
 
     //
     // Look Ahead 
@@ -296,16 +384,18 @@ private:
     bool 
     componentPresent(HydNetComp *comp)
     {
-        return (findComponent(comp->ID(), comp->hydType()) != nullptr) ? true : false;
+        return (isLink(comp->hydType()) ? linkPos(comp->ID()) : nodePos(comp->ID())) >= 0;
     }
     
     template<typename T> 
-    T* find(const std::string& hid, const std::map<std::string, T*>& index) const
+    T* get(int pos, HydType type) const
     {
-        auto comp = index.find(hid);
-        return (comp != index.end()) ? comp->second : nullptr;
+        return (pos >= 0 && m_vComponents[pos]->hydType() == type) ? static_cast<T*>(m_vComponents[pos]) : nullptr;
     }
     
+    static bool
+    isLink(HydType type) { return type == HydType::Pipe || type == HydType::Pump || type == HydType::Valve; }
+    
     void
     getMinMaxXY( HydVertex& min, HydVertex& max, const HydVertex& coord )
     {
@@ -365,16 +455,23 @@ private:
 	std::vector<HydPump*>      m_vPumps;
 	std::vector<HydValve*>     m_vValves;
 
-    std::map<std::string, HydJunction*>  m_junctionIndex;
-    std::map<std::string, HydPipe*>      m_pipeIndex;
-    std::map<std::string, HydReservoir*> m_reservoirIndex;
-    std::map<std::string, HydTank*>      m_tankIndex;
-    std::map<std::string, HydPump*>      m_pumpIndex;    
-    std::map<std::string, HydValve*>     m_valveIndex;
+    // ID to pos() 
+    HydIDIndex m_linkIndex;
+    HydIDIndex m_nodeIndex;
+    
+    HydIncidence m_incidence;
+    
+    // diameter uniformity cache
+    std::vector<HydFloat> m_uniformity;             /// by junction
+    std::vector<HydFloat> m_uniformityDiameter;     /// by pipe, the diameter m_uniformity was calculated with
+    std::vector<int>      m_junctionSlot;           /// by handle, the position in junctions() or -1
+    std::vector<char>     m_uniformityStale;        /// by junction
 
     std::map<std::string, HydOptions> m_options;
     std::vector<long> m_vTimePoints;
     HydLookAhead m_lookAhead;
+    
+    HydTimeSeries m_series;
 };
 
 #endif // !_HYDNETWORK_H_
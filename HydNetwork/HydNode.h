@@ -52,9 +52,9 @@ public:
     
     virtual ~HydNode(void) override=default;
     
-    const std::vector<HydFloat>& pressure(void) const { return m_pressure; }
+    const HydSeries<HydFloat>& pressure(void) const { return m_pressure; }
     void addPressure(const HydFloat pressure) { m_pressure.push_back(pressure); } 
-    void setPressure(const HydFloat pressure) { m_pressure = std::vector<HydFloat>(1,pressure); } 
+    void setPressure(const HydFloat pressure) { m_pressure.assign(1,pressure); } 
     void setPressure(const std::vector<HydFloat>& pressure) { m_pressure = pressure; }
     HydFloat maxPressure(void) const { return *std::max_element(m_pressure.begin(), m_pressure.end()); }
     HydFloat minPressure(void) const { return *std::min_element(m_pressure.begin(), m_pressure.end()); }
@@ -70,6 +70,13 @@ public:
     HydFloat scale3D(void) const { return m_scale3D; }
     void setScale3D(HydFloat scale_3d) { m_scale3D = scale_3d; }
     
+    void
+    bindSeries(HydTimeSeries& series, int slot) override
+    {
+        series.bind(m_quality, series.nodeQuality(), slot);
+        series.bind(m_pressure, series.pressure(), slot);
+    }
+    
 protected:
  
 	HydFloat m_scale3D;
@@ -77,7 +84,7 @@ protected:
     HydVertex m_vertex;
     
     HydSourceQuality m_sourceQuality;
-    std::vector<HydFloat> m_pressure;
+    HydSeries<HydFloat> m_pressure;
 };
 
 
@@ -36,7 +36,7 @@ HydObjective::getMinMaxCost( HydNetwork* hydNet )
         HydPipe* pipe = *i;
         if (pipe->isDecisionVariable())
         {
-            HydOptions options = hydNet->options(HydType::Pipe, pipe->group());
+            const HydOptions& options = hydNet->options(HydType::Pipe, pipe->group());
             min_cost += options.min_cost() * pipe->length();
             max_cost += options.max_cost() * pipe->length();
         }
@@ -58,7 +58,7 @@ HydObjective::cost( HydNetwork* hydNet )
         
         if (pipe->isDecisionVariable())
         {
-            HydOptions options = hydNet->options(HydType::Pipe, pipe->group());
+            const HydOptions& options = hydNet->options(HydType::Pipe, pipe->group());
             for (int j = 0; j < options.size(); ++j)
             {
                 HydFloat diam = options.value(j); // anycode
@@ -133,6 +133,56 @@ HydObjective::headDeficit( HydNetwork* hydNet, int scenario_index )
     return total_deficit;
 }
 
+bool
+HydObjective::headDeficit( HydNetwork* hydNet, std::vector<HydFloat>& deficit, HydFloat bound )
+// all the time points of a simulation run in one pass over each junction's (contiguous) head series
+// the sums for each time point are accumulated in the same order as headDeficit(hydNet, scenario_index)
+{
+    const std::vector<HydJunction*>& junctions = hydNet->junctions();
+    
+    const int numTimePoints = junctions.empty() ? 0 : junctions[0]->totalHead().size();
+    
+    deficit.assign(numTimePoints, 0.0);
+    HydFloat* total = deficit.data();
+    
+    const bool bounded = bound < std::numeric_limits<HydFloat>::max();
+    
+    for (int j = 0; j < junctions.size(); ++j)
+    {
+        HydJunction* junction = junctions[j];
+        if (!junction->isDecisionVariable())
+            continue;
+        
+        assert(junction->minHead().size() >= numTimePoints);
+        
+        const HydFloat* head     = junction->totalHead().data();
+        const HydFloat* min_head = junction->minHead().data();
+        
+        // Note this sets a variable
+        HydFloat* head_deficit = junction->resizeHeadDeficit(numTimePoints);
+        HydFloat* head_excess  = junction->resizeHeadExcess(numTimePoints);
+        
+        // selects rather than branches - the compiler vectorises this loop
+        for (int t = 0; t < numTimePoints; ++t)
+        {
+            HydFloat d = min_head[t] - head[t];
+            
+            head_deficit[t] = (d < 0.0f) ? 0.0f : d;
+            head_excess[t]  = (d < 0.0f) ? -d : 0.0f;
+            total[t]       += (d > 0.0f) ? d : 0.0f;
+        }
+        
+        // the totals only increase so once one time point exceeds the bound the worst case does too
+        if (bounded && (j % 32 == 31) && *std::max_element(total, total + numTimePoints) > bound)
+            return false;
+    }
+    
+    if (bounded && numTimePoints > 0 && *std::max_element(total, total + numTimePoints) > bound)
+        return false;
+    
+    return true;
+}
+
 
 HydFloat
 HydObjective::resilience( HydNetwork* hydNet, int scenario_index )
@@ -147,34 +197,18 @@ HydObjective::resilience( HydNetwork* hydNet, int scenario_index )
     
     assert(scenario_index < junctions[0]->minHead().size());
     
-    for (auto i = junctions.begin(); i != junctions.end(); ++i)
+    // the diameter uniformity of each junction only changes when a pipe diameter changes
+    const std::vector<HydFloat>& uniformity = hydNet->diameterUniformity();
+    
+    for (int j = 0; j < junctions.size(); ++j)
     {
-        HydJunction* junction = *i;
-        
-        std::vector<HydFloat> pipe_diams; // diameters of pipes connected to this junction
-        
-        const std::vector<HydPipe*>& pipes = hydNet->pipes();
-        for (auto j = pipes.begin(); j != pipes.end(); ++j)
-        {
-            HydPipe* pipe = *j;
-            if (pipe->fromNodeID() == junction->ID() || pipe->toNodeID() == junction->ID())
-                pipe_diams.push_back(pipe->diameter());
-        }
+        HydJunction* junction = junctions[j];
         
-        HydFloat diameter_uniformity = 0.0;
-        if (pipe_diams.size() > 0)
-        {
-            HydFloat sum = util::sum(pipe_diams);
-            HydFloat max = *std::max_element(pipe_diams.begin(), pipe_diams.end());
-            diameter_uniformity = sum / (pipe_diams.size() * max);
-        }
-        else
-        {
-            std::cout << "ERROR orphan junction" << std::endl;
-        }
+        HydFloat demand   = junction->actualDemand()[scenario_index];
+        HydFloat min_head = junction->minHead()[scenario_index];
         
-        junction_dissipation += diameter_uniformity * junction->actualDemand()[scenario_index] * (junction->totalHead()[scenario_index] - junction->minHead()[scenario_index]);
-        junction_minimum_power += junction->actualDemand()[scenario_index] * junction->minHead()[scenario_index];
+        junction_dissipation += uniformity[j] * demand * (junction->totalHead()[scenario_index] - min_head);
+        junction_minimum_power += demand * min_head;
     }
     
     HydFloat reservoir_supply_energy = 0.0;
@@ -190,3 +224,59 @@ HydObjective::resilience( HydNetwork* hydNet, int scenario_index )
 
     return resil;
 }
+
+void
+HydObjective::resilience( HydNetwork* hydNet, std::vector<HydFloat>& resil )
+// all the time points of a simulation run in one pass over each junction's (contiguous) demand and head series
+// the sums for each time point are accumulated in the same order as resilience(hydNet, scenario_index)
+{
+    const std::vector<HydJunction*>& junctions = hydNet->junctions();
+    const std::vector<HydReservoir*>& reservoirs = hydNet->reservoirs();
+    
+    const int numTimePoints = junctions.empty() ? 0 : junctions[0]->actualDemand().size();
+    
+    std::vector<HydFloat> dissipation(numTimePoints, 0.0);
+    std::vector<HydFloat> minimum_power(numTimePoints, 0.0);
+    std::vector<HydFloat> supply_energy(numTimePoints, 0.0);
+    
+    HydFloat* diss   = dissipation.data();
+    HydFloat* power  = minimum_power.data();
+    HydFloat* supply = supply_energy.data();
+    
+    const std::vector<HydFloat>& uniformity = hydNet->diameterUniformity();
+    
+    for (int j = 0; j < junctions.size(); ++j)
+    {
+        const HydJunction* junction = junctions[j];
+        
+        assert(junction->minHead().size() >= numTimePoints);
+        assert(junction->totalHead().size() >= numTimePoints);
+        
+        const HydFloat  u        = uniformity[j];
+        const HydFloat* demand   = junction->actualDemand().data();
+        const HydFloat* head     = junction->totalHead().data();
+        const HydFloat* min_head = junction->minHead().data();
+        
+        // no branches or calls - the compiler vectorises this loop
+        for (int t = 0; t < numTimePoints; ++t)
+        {
+            diss[t]  += u * demand[t] * (head[t] - min_head[t]);
+            power[t] += demand[t] * min_head[t];
+        }
+    }
+    
+    for (int r = 0; r < reservoirs.size(); ++r)
+    {
+        const HydFloat  elevation  = reservoirs[r]->elevation();
+        const HydFloat* net_inflow = reservoirs[r]->netInflow().data();
+        
+        assert(reservoirs[r]->netInflow().size() >= numTimePoints);
+        
+        for (int t = 0; t < numTimePoints; ++t)
+            supply[t] += std::fabs(net_inflow[t] * elevation);
+    }
+    
+    resil.resize(numTimePoints);
+    for (int t = 0; t < numTimePoints; ++t)
+        resil[t] = diss[t] / (supply[t] - power[t]);
+}
@@ -20,6 +20,9 @@
 #include "HydTypes.h" 
 #endif
 
+#include <vector>
+#include <limits>
+
 
 
 class HydNetwork;
@@ -31,6 +34,10 @@ public:
     static HydFloat
     resilience( HydNetwork* hydNet, int scenario_index = 0 );
     
+    // the resilience at every time point held by hydNet
+    static void
+    resilience( HydNetwork* hydNet, std::vector<HydFloat>& resil );
+    
     static HydFloat
     cost( HydNetwork* hydNet );
     
@@ -41,6 +48,12 @@ public:
     static HydFloat
     headDeficit( HydNetwork* hydNet, int scenario_index = 0 );
     
+    // the head deficit at every time point held by hydNet - sets the head deficit/excess series of every junction
+    // returns false as soon as the deficit at some time point exceeds bound; the totals (and the junction series) 
+    // are then incomplete, but the largest total still exceeds bound
+    static bool
+    headDeficit( HydNetwork* hydNet, std::vector<HydFloat>& deficit, HydFloat bound = std::numeric_limits<HydFloat>::max() );
+    
 private:
 
     HydObjective( void )=delete;
@@ -0,0 +1,125 @@
+/* HydResults 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$
+ $   HydResults.h   $
+ $$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ The hydraulic results for a single time step copied out of an EPANET project in one pass.
+ Values are converted to user units and stored in contiguous arrays indexed by EPANET
+ node/link index 1,2,...  (element 0 is unused)
+
+ This replaces a separate EN_getnodevalue/EN_getlinkvalue call for each value - see HydEPANET::extractResults()
+
+*/
+
+
+#ifndef __HYDRESULTS_H__
+#define __HYDRESULTS_H__
+
+#include <vector>
+
+class HydResults
+{
+public:
+
+    HydResults( void ) : m_numNodes(0), m_numLinks(0) {}
+    ~HydResults( void )=default;
+
+    // allocates storage - does nothing if the sizes are unchanged
+    void
+    resize( int numNodes, int numLinks )
+    {
+        if (numNodes != m_numNodes)
+        {
+            m_numNodes = numNodes;
+            m_demand.assign(numNodes + 1, 0.0);
+            m_head.assign(numNodes + 1, 0.0);
+            m_pressure.assign(numNodes + 1, 0.0);
+            m_nodeQuality.assign(numNodes + 1, 0.0);
+        }
+
+        if (numLinks != m_numLinks)
+        {
+            m_numLinks = numLinks;
+            m_flow.assign(numLinks + 1, 0.0);
+            m_velocity.assign(numLinks + 1, 0.0);
+            m_headloss.assign(numLinks + 1, 0.0);
+            m_status.assign(numLinks + 1, 0.0);
+            m_diameter.assign(numLinks + 1, 0.0);
+            m_roughness.assign(numLinks + 1, 0.0);
+            m_linkQuality.assign(numLinks + 1, 0.0);
+        }
+    }
+
+    int numNodes( void ) const { return m_numNodes; }
+    int numLinks( void ) const { return m_numLinks; }
+
+    // node results
+    double demand( int node_idx ) const { return m_demand[node_idx]; }
+    double head( int node_idx ) const { return m_head[node_idx]; }
+    double pressure( int node_idx ) const { return m_pressure[node_idx]; }
+    double nodeQuality( int node_idx ) const { return m_nodeQuality[node_idx]; }
+
+    // link results - status is 0.0 for closed and 1.0 for open
+    double flow( int link_idx ) const { return m_flow[link_idx]; }
+    double velocity( int link_idx ) const { return m_velocity[link_idx]; }
+    double headloss( int link_idx ) const { return m_headloss[link_idx]; }
+    double status( int link_idx ) const { return m_status[link_idx]; }
+    double diameter( int link_idx ) const { return m_diameter[link_idx]; }
+    double roughness( int link_idx ) const { return m_roughness[link_idx]; }
+    double linkQuality( int link_idx ) const { return m_linkQuality[link_idx]; }
+
+    // whole arrays
+    const std::vector<double>& demand( void ) const { return m_demand; }
+    const std::vector<double>& head( void ) const { return m_head; }
+    const std::vector<double>& pressure( void ) const { return m_pressure; }
+    const std::vector<double>& nodeQuality( void ) const { return m_nodeQuality; }
+
+    const std::vector<double>& flow( void ) const { return m_flow; }
+    const std::vector<double>& velocity( void ) const { return m_velocity; }
+    const std::vector<double>& headloss( void ) const { return m_headloss; }
+    const std::vector<double>& status( void ) const { return m_status; }
+    const std::vector<double>& diameter( void ) const { return m_diameter; }
+    const std::vector<double>& roughness( void ) const { return m_roughness; }
+    const std::vector<double>& linkQuality( void ) const { return m_linkQuality; }
+
+    // write access for the simulator
+    std::vector<double>& demand( void ) { return m_demand; }
+    std::vector<double>& head( void ) { return m_head; }
+    std::vector<double>& pressure( void ) { return m_pressure; }
+    std::vector<double>& nodeQuality( void ) { return m_nodeQuality; }
+
+    std::vector<double>& flow( void ) { return m_flow; }
+    std::vector<double>& velocity( void ) { return m_velocity; }
+    std::vector<double>& headloss( void ) { return m_headloss; }
+    std::vector<double>& status( void ) { return m_status; }
+    std::vector<double>& diameter( void ) { return m_diameter; }
+    std::vector<double>& roughness( void ) { return m_roughness; }
+    std::vector<double>& linkQuality( void ) { return m_linkQuality; }
+
+private:
+
+    int m_numNodes;
+    int m_numLinks;
+
+    std::vector<double> m_demand;
+    std::vector<double> m_head;
+    std::vector<double> m_pressure;
+    std::vector<double> m_nodeQuality;
+
+    std::vector<double> m_flow;
+    std::vector<double> m_velocity;
+    std::vector<double> m_headloss;
+    std::vector<double> m_status;
+    std::vector<double> m_diameter;
+    std::vector<double> m_roughness;
+    std::vector<double> m_linkQuality;
+};
+
+#endif
+
+
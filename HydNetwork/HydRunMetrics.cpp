@@ -0,0 +1,221 @@
+/* HydRunMetrics 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$$$$$
+ $   HydRunMetrics.cpp   $
+ $$$$$$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+*/
+
+
+#ifndef __HYDRUNMETRICS_H__
+#include "HydRunMetrics.h"
+#endif
+
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+
+void
+HydRunMetrics::clear( void )
+{
+    m_iterations.clear();
+    m_relativeErrors.clear();
+
+    for (int i = 0; i <= NUM_WARNINGS; ++i)
+        m_warnings[i] = 0;
+
+    m_assemblyTime = 0.0;
+    m_solveTime = 0.0;
+    m_extractTime = 0.0;
+    m_runTime = 0.0;
+}
+
+int
+HydRunMetrics::totalIterations( void ) const
+{
+    int total = 0;
+    for (int i = 0; i < m_iterations.size(); ++i)
+        total += m_iterations[i];
+    return total;
+}
+
+int
+HydRunMetrics::maxIterations( void ) const
+{
+    int max_iter = 0;
+    for (int i = 0; i < m_iterations.size(); ++i)
+        max_iter = std::max(max_iter, m_iterations[i]);
+    return max_iter;
+}
+
+int
+HydRunMetrics::numWarnings( void ) const
+{
+    int total = 0;
+    for (int i = 1; i <= NUM_WARNINGS; ++i)
+        total += m_warnings[i];
+    return total;
+}
+
+
+void
+HydRunHistogram::clear( void )
+{
+    m_runs = 0;
+    m_steps = 0;
+    m_iterations = 0;
+    m_maxIterations = 0;
+    m_maxRunTime = 0.0;
+
+    for (int i = 0; i <= HydRunMetrics::NUM_WARNINGS; ++i)
+        m_warnings[i] = 0;
+
+    m_assemblyTime = 0.0;
+    m_solveTime = 0.0;
+    m_extractTime = 0.0;
+    m_runTime = 0.0;
+
+    for (int i = 0; i < NUM_BINS; ++i)
+    {
+        m_iterationBins[i] = 0;
+        m_stepBins[i] = 0;
+        m_timeBins[i] = 0;
+    }
+}
+
+int
+HydRunHistogram::bin( double x )
+{
+    int b = 0;
+    while (x >= 2.0 && b < NUM_BINS - 1)
+    {
+        x *= 0.5;
+        ++b;
+    }
+    return b;
+}
+
+void
+HydRunHistogram::add( const HydRunMetrics& metrics )
+{
+    int iterations = metrics.totalIterations();
+
+    ++m_runs;
+    m_steps += metrics.steps();
+    m_iterations += iterations;
+    m_maxIterations = std::max(m_maxIterations, iterations);
+    m_maxRunTime = std::max(m_maxRunTime, metrics.runTime());
+
+    for (int i = 1; i <= HydRunMetrics::NUM_WARNINGS; ++i)
+        m_warnings[i] += metrics.warnings(i);
+
+    m_assemblyTime += metrics.assemblyTime();
+    m_solveTime += metrics.solveTime();
+    m_extractTime += metrics.extractTime();
+    m_runTime += metrics.runTime();
+
+    ++m_iterationBins[bin(iterations)];
+    ++m_stepBins[bin(metrics.steps())];
+    ++m_timeBins[bin(metrics.runTime() * 1.0E6)];
+}
+
+void
+HydRunHistogram::add( const HydRunHistogram& histogram )
+{
+    m_runs += histogram.m_runs;
+    m_steps += histogram.m_steps;
+    m_iterations += histogram.m_iterations;
+    m_maxIterations = std::max(m_maxIterations, histogram.m_maxIterations);
+    m_maxRunTime = std::max(m_maxRunTime, histogram.m_maxRunTime);
+
+    for (int i = 1; i <= HydRunMetrics::NUM_WARNINGS; ++i)
+        m_warnings[i] += histogram.m_warnings[i];
+
+    m_assemblyTime += histogram.m_assemblyTime;
+    m_solveTime += histogram.m_solveTime;
+    m_extractTime += histogram.m_extractTime;
+    m_runTime += histogram.m_runTime;
+
+    for (int i = 0; i < NUM_BINS; ++i)
+    {
+        m_iterationBins[i] += histogram.m_iterationBins[i];
+        m_stepBins[i] += histogram.m_stepBins[i];
+        m_timeBins[i] += histogram.m_timeBins[i];
+    }
+}
+
+void
+HydRunHistogram::print( const std::string& title, const long *counts, std::vector<std::string>& lines )
+{
+    const int barLength = 40;
+
+    int first = 0, last = NUM_BINS - 1;
+    while (first < NUM_BINS && counts[first] == 0)
+        ++first;
+    while (last > first && counts[last] == 0)
+        --last;
+
+    if (first == NUM_BINS)
+        return;
+
+    long max_count = *std::max_element(counts + first, counts + last + 1);
+
+    lines.push_back(title);
+    for (int i = first; i <= last; ++i)
+    {
+        std::ostringstream txt;
+        std::ostringstream range;
+
+        range << '[' << ((i == 0) ? 0L : (1L << i)) << ", ";
+        if (i < NUM_BINS - 1)
+            range << (1L << (i + 1)) << ')';
+        else range << "...)";
+
+        txt << std::setw(20) << range.str() << std::setw(10) << counts[i] << "  "
+            << std::string((barLength * counts[i] + max_count - 1) / max_count, '#');
+        lines.push_back(txt.str());
+    }
+}
+
+std::vector<std::string>
+HydRunHistogram::toStrings( void ) const
+{
+    static const char *warningNames[HydRunMetrics::NUM_WARNINGS + 1] = { "",
+        "unbalanced", "unstable", "disconnected", "pumps", "valves", "negative pressures" };
+
+    std::vector<std::string> lines;
+
+    if (m_runs == 0)
+        return lines;
+
+    double n = (double) m_runs;
+
+    std::ostringstream txt1;
+    txt1.precision(3);
+    txt1.setf( std::ios::fixed, std::ios::floatfield );
+    txt1 << "Hydraulic solver " << m_runs << " runs with " << m_steps / n << " steps, " << m_iterations / n << " iterations and "
+         << 1000.0 * m_runTime / n << " ms per run (assembly " << 1000.0 * m_assemblyTime / n << " ms, solve "
+         << 1000.0 * m_solveTime / n << " ms, extraction " << 1000.0 * m_extractTime / n << " ms); max "
+         << m_maxIterations << " iterations, max " << 1000.0 * m_maxRunTime << " ms";
+    lines.push_back(txt1.str());
+
+    std::ostringstream txt2;
+    txt2 << "Warnings";
+    for (int i = 1; i <= HydRunMetrics::NUM_WARNINGS; ++i)
+        txt2 << "  " << warningNames[i] << ' ' << m_warnings[i];
+    lines.push_back(txt2.str());
+
+    print("Iterations per run", m_iterationBins, lines);
+    print("Time steps per run", m_stepBins, lines);
+    print("Run time (microseconds)", m_timeBins, lines);
+
+    return lines;
+}
+
+//
+
@@ -0,0 +1,176 @@
+/* HydRunMetrics 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$$$
+ $   HydRunMetrics.h   $
+ $$$$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ Solver telemetry for EPANET hydraulic runs - see HydEPANET::runMetrics()
+
+ HydRunMetrics records a single run(): the Newton iterations and relative flow change of each
+ hydraulic time step (including the intermediate steps caused by controls and tanks filling/emptying),
+ the wall time spent assembling the linear system, factorising/solving it and extracting the results,
+ and the EPANET warnings (codes 1-6) raised during the run.
+
+ HydRunHistogram aggregates many runs into log2 histograms of iterations, time steps and run time
+ so that the occasional slow simulation can be spotted. Histograms from several HydEPANETs
+ (e.g. a HOWSEvaluatorPool) can be merged with add().
+
+*/
+
+
+#ifndef __HYDRUNMETRICS_H__
+#define __HYDRUNMETRICS_H__
+
+#include <string>
+#include <vector>
+
+class HydRunMetrics
+{
+public:
+
+    // EPANET warning codes are 1,...,NUM_WARNINGS
+    static const int NUM_WARNINGS = 6;
+
+    HydRunMetrics( void ) : m_iterations(), m_relativeErrors() { clear(); }
+    ~HydRunMetrics( void )=default;
+
+    void
+    clear( void );
+
+    // record a hydraulic time step
+    void
+    addStep( int iterations, double relativeError )
+    {
+        m_iterations.push_back(iterations);
+        m_relativeErrors.push_back(relativeError);
+    }
+
+    // record an EPANET warning - other codes are ignored
+    void
+    addWarning( int code )
+    {
+        if (code >= 1 && code <= NUM_WARNINGS)
+            ++m_warnings[code];
+    }
+
+    // number of hydraulic time steps
+    int
+    steps( void ) const { return (int) m_iterations.size(); }
+
+    // iterations and final relative flow change of each time step
+    const std::vector<int>&
+    iterations( void ) const { return m_iterations; }
+
+    const std::vector<double>&
+    relativeErrors( void ) const { return m_relativeErrors; }
+
+    int
+    totalIterations( void ) const;
+
+    int
+    maxIterations( void ) const;
+
+    // number of times warning code was raised (code 1,...,NUM_WARNINGS)
+    int
+    warnings( int code ) const { return m_warnings[code]; }
+
+    int
+    numWarnings( void ) const;
+
+    // wall times in seconds
+    double assemblyTime( void ) const { return m_assemblyTime; }
+    double solveTime( void ) const { return m_solveTime; }
+    double extractTime( void ) const { return m_extractTime; }
+    double runTime( void ) const { return m_runTime; }
+
+    void setAssemblyTime( double t ) { m_assemblyTime = t; }
+    void setSolveTime( double t ) { m_solveTime = t; }
+    void setExtractTime( double t ) { m_extractTime = t; }
+    void setRunTime( double t ) { m_runTime = t; }
+
+private:
+
+    std::vector<int>    m_iterations;
+    std::vector<double> m_relativeErrors;
+
+    int m_warnings[NUM_WARNINGS + 1];
+
+    double m_assemblyTime;
+    double m_solveTime;
+    double m_extractTime;
+    double m_runTime;
+};
+
+
+class HydRunHistogram
+{
+public:
+
+    // bin b holds values in [2^b, 2^(b+1)), bin 0 holds [0, 2) and the last bin holds everything larger
+    static const int NUM_BINS = 24;
+
+    HydRunHistogram( void ) { clear(); }
+    ~HydRunHistogram( void )=default;
+
+    void
+    clear( void );
+
+    // aggregate a run
+    void
+    add( const HydRunMetrics& metrics );
+
+    // merge another histogram
+    void
+    add( const HydRunHistogram& histogram );
+
+    long
+    runs( void ) const { return m_runs; }
+
+    long
+    warnings( int code ) const { return m_warnings[code]; }
+
+    // totals over all runs - times in seconds
+    long totalSteps( void ) const { return m_steps; }
+    long totalIterations( void ) const { return m_iterations; }
+    double assemblyTime( void ) const { return m_assemblyTime; }
+    double solveTime( void ) const { return m_solveTime; }
+    double extractTime( void ) const { return m_extractTime; }
+    double runTime( void ) const { return m_runTime; }
+
+    // a summary line, the warning counts, then the non-empty part of each histogram, one line per bin
+    std::vector<std::string>
+    toStrings( void ) const;
+
+private:
+
+    static int
+    bin( double x );
+
+    static void
+    print( const std::string& title, const long *counts, std::vector<std::string>& lines );
+
+    long m_runs;
+    long m_steps;
+    long m_iterations;
+    int  m_maxIterations;
+    double m_maxRunTime;
+
+    long m_warnings[HydRunMetrics::NUM_WARNINGS + 1];
+
+    double m_assemblyTime;
+    double m_solveTime;
+    double m_extractTime;
+    double m_runTime;
+
+    long m_iterationBins[NUM_BINS];   // iterations per run
+    long m_stepBins[NUM_BINS];        // time steps per run
+    long m_timeBins[NUM_BINS];        // run time in microseconds
+};
+
+#endif
+
+
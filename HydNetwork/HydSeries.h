@@ -0,0 +1,155 @@
+/* HydSeries 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$
+ $   HydSeries.h   $
+ $$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ The time series of a simulation result held by a network component (i.e. the flow in a pipe at each time point)
+
+ A HydSeries is a view of a slot in the contiguous [component x time point] arrays of a HydTimeSeries
+ owned by the HydNetwork - see HydNetwork::reserveTimePoints(). Adding a value writes into that slot, so
+ refilling a series after HydNetwork::clear() does not allocate. A series that is not bound to a
+ HydTimeSeries, is copied, or outgrows its slot holds its own values.
+
+ It behaves like a const std::vector<T> for reading (size(), [], begin(), end(), back(), ...).
+
+*/
+
+
+#ifndef __HYDSERIES_H__
+#define __HYDSERIES_H__
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+
+template <typename T>
+class HydSeries
+{
+public:
+
+    typedef T value_type;
+    typedef const T* iterator;
+    typedef const T* const_iterator;
+
+    HydSeries( void ) : m_data(nullptr), m_size(0), m_capacity(0), m_own() {}
+
+    HydSeries( const HydSeries& s ) : m_data(nullptr), m_size(0), m_capacity(0), m_own() { assign(s.begin(), s.end()); }
+
+    ~HydSeries( void )=default;
+
+    HydSeries&
+    operator=( const HydSeries& s )
+    {
+        if (this != &s)
+            assign(s.begin(), s.end());
+        return *this;
+    }
+
+    HydSeries&
+    operator=( const std::vector<T>& v )
+    {
+        assign(v.begin(), v.end());
+        return *this;
+    }
+
+    operator std::vector<T>( void ) const { return std::vector<T>(begin(), end()); }
+
+    int size( void ) const { return m_size; }
+    bool empty( void ) const { return m_size == 0; }
+
+    const T* data( void ) const { return m_data; }
+    const T* begin( void ) const { return m_data; }
+    const T* end( void ) const { return m_data + m_size; }
+
+    const T& operator[]( int i ) const { assert(i < m_size); return m_data[i]; }
+    const T& front( void ) const { return m_data[0]; }
+    const T& back( void ) const { return m_data[m_size - 1]; }
+
+    // true if the values are held in a HydTimeSeries
+    bool
+    isBound( void ) const { return m_data != nullptr && m_own.empty(); }
+
+    void
+    clear( void ) { m_size = 0; }
+
+    void
+    push_back( const T& x )
+    {
+        if (m_size == m_capacity)
+            reallocate(std::max(1, 2 * m_capacity));
+        m_data[m_size++] = x;
+    }
+
+    void
+    assign( int n, const T& x )
+    {
+        if (n > m_capacity)
+            reallocate(n);
+        std::fill(m_data, m_data + n, x);
+        m_size = n;
+    }
+
+    // set the size to n and return the values to be written (the first min(n, size()) values are kept)
+    T*
+    resize( int n )
+    {
+        if (n > m_capacity)
+            reallocate(n);
+        m_size = n;
+        return m_data;
+    }
+
+    template <typename Iter>
+    void
+    assign( Iter first, Iter last )
+    {
+        int n = (int) std::distance(first, last);
+        if (n > m_capacity)
+            reallocate(n);
+        std::copy(first, last, m_data);
+        m_size = n;
+    }
+
+    // move the values into capacity elements of storage owned by a HydTimeSeries
+    // a series that does not fit keeps its own storage
+    void
+    bind( T* data, int capacity )
+    {
+        if (m_size > capacity)
+            return;
+
+        std::copy(begin(), end(), data);
+        m_data = data;
+        m_capacity = capacity;
+        std::vector<T>().swap(m_own);
+    }
+
+private:
+
+    // the existing values are kept - the series no longer refers to a HydTimeSeries
+    void
+    reallocate( int capacity )
+    {
+        std::vector<T> own(capacity);
+        std::copy(begin(), end(), own.begin());
+        m_own.swap(own);
+        m_data = m_own.data();
+        m_capacity = capacity;
+    }
+
+    T  *m_data;
+    int m_size;
+    int m_capacity;
+
+    std::vector<T> m_own;
+};
+
+#endif
+
+
@@ -0,0 +1,168 @@
+/* HydTimeSeries 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$$$
+ $   HydTimeSeries.h   $
+ $$$$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ The simulation results of all the components of a HydNetwork stored as structure of arrays
+
+ Each quantity is a contiguous [component x time point] array. Component c occupies elements
+ c * timePoints(),...,(c + 1) * timePoints() - 1, where c is the position of a link in HydNetwork::links()
+ or of a node in HydNetwork::nodes(). The components read and write their slots through HydSeries views
+ - see HydNetComp::bindSeries()
+
+ The arrays are allocated once by HydNetwork::reserveTimePoints() and reused by every simulation run.
+
+*/
+
+
+#ifndef __HYDTIMESERIES_H__
+#define __HYDTIMESERIES_H__
+
+#ifndef __HYDTYPES_H__
+#include "HydTypes.h"
+#endif
+
+#ifndef __HYDSERIES_H__
+#include "HydSeries.h"
+#endif
+
+#include <vector>
+
+
+class HydTimeSeries
+{
+public:
+
+    HydTimeSeries( void ) : m_numNodes(0), m_numLinks(0), m_timePoints(0) {}
+    ~HydTimeSeries( void )=default;
+
+    void
+    resize( int numNodes, int numLinks, int timePoints )
+    {
+        m_numNodes = numNodes;
+        m_numLinks = numLinks;
+        m_timePoints = timePoints;
+
+        const size_t nodeSize = (size_t) numNodes * timePoints;
+        const size_t linkSize = (size_t) numLinks * timePoints;
+
+        m_pressure.assign(nodeSize, 0.0);
+        m_nodeQuality.assign(nodeSize, 0.0);
+        m_totalHead.assign(nodeSize, 0.0);
+        m_headDeficit.assign(nodeSize, 0.0);
+        m_headExcess.assign(nodeSize, 0.0);
+        m_actualDemand.assign(nodeSize, 0.0);
+        m_netInflow.assign(nodeSize, 0.0);
+
+        m_flow.assign(linkSize, 0.0);
+        m_velocity.assign(linkSize, 0.0);
+        m_unitHeadloss.assign(linkSize, 0.0);
+        m_frictionFactor.assign(linkSize, 0.0);
+        m_reactionRate.assign(linkSize, 0.0);
+        m_linkQuality.assign(linkSize, 0.0);
+        m_status.assign(linkSize, LinkStatusOption::Closed);
+    }
+
+    void
+    swap( HydTimeSeries& series )
+    {
+        std::swap(m_numNodes, series.m_numNodes);
+        std::swap(m_numLinks, series.m_numLinks);
+        std::swap(m_timePoints, series.m_timePoints);
+
+        m_pressure.swap(series.m_pressure);
+        m_nodeQuality.swap(series.m_nodeQuality);
+        m_totalHead.swap(series.m_totalHead);
+        m_headDeficit.swap(series.m_headDeficit);
+        m_headExcess.swap(series.m_headExcess);
+        m_actualDemand.swap(series.m_actualDemand);
+        m_netInflow.swap(series.m_netInflow);
+
+        m_flow.swap(series.m_flow);
+        m_velocity.swap(series.m_velocity);
+        m_unitHeadloss.swap(series.m_unitHeadloss);
+        m_frictionFactor.swap(series.m_frictionFactor);
+        m_reactionRate.swap(series.m_reactionRate);
+        m_linkQuality.swap(series.m_linkQuality);
+        m_status.swap(series.m_status);
+    }
+
+    int numNodes( void ) const { return m_numNodes; }
+    int numLinks( void ) const { return m_numLinks; }
+
+    // the number of time points held for each component - the stride of each array
+    int timePoints( void ) const { return m_timePoints; }
+
+    // bind a component's series to its slot of array a (one of the arrays below)
+    void bind( HydSeries<HydFloat>& s, std::vector<HydFloat>& a, int slot ) { s.bind(&a[(size_t) slot * m_timePoints], m_timePoints); }
+    void bind( HydSeries<LinkStatusOption>& s, int slot ) { s.bind(&m_status[(size_t) slot * m_timePoints], m_timePoints); }
+
+    // node arrays
+    std::vector<HydFloat>& pressure( void ) { return m_pressure; }
+    std::vector<HydFloat>& nodeQuality( void ) { return m_nodeQuality; }
+    std::vector<HydFloat>& totalHead( void ) { return m_totalHead; }
+    std::vector<HydFloat>& headDeficit( void ) { return m_headDeficit; }
+    std::vector<HydFloat>& headExcess( void ) { return m_headExcess; }
+    std::vector<HydFloat>& actualDemand( void ) { return m_actualDemand; }
+    std::vector<HydFloat>& netInflow( void ) { return m_netInflow; }
+
+    const std::vector<HydFloat>& pressure( void ) const { return m_pressure; }
+    const std::vector<HydFloat>& nodeQuality( void ) const { return m_nodeQuality; }
+    const std::vector<HydFloat>& totalHead( void ) const { return m_totalHead; }
+    const std::vector<HydFloat>& headDeficit( void ) const { return m_headDeficit; }
+    const std::vector<HydFloat>& headExcess( void ) const { return m_headExcess; }
+    const std::vector<HydFloat>& actualDemand( void ) const { return m_actualDemand; }
+    const std::vector<HydFloat>& netInflow( void ) const { return m_netInflow; }
+
+    // link arrays
+    std::vector<HydFloat>& flow( void ) { return m_flow; }
+    std::vector<HydFloat>& velocity( void ) { return m_velocity; }
+    std::vector<HydFloat>& unitHeadloss( void ) { return m_unitHeadloss; }
+    std::vector<HydFloat>& frictionFactor( void ) { return m_frictionFactor; }
+    std::vector<HydFloat>& reactionRate( void ) { return m_reactionRate; }
+    std::vector<HydFloat>& linkQuality( void ) { return m_linkQuality; }
+
+    const std::vector<HydFloat>& flow( void ) const { return m_flow; }
+    const std::vector<HydFloat>& velocity( void ) const { return m_velocity; }
+    const std::vector<HydFloat>& unitHeadloss( void ) const { return m_unitHeadloss; }
+    const std::vector<HydFloat>& frictionFactor( void ) const { return m_frictionFactor; }
+    const std::vector<HydFloat>& reactionRate( void ) const { return m_reactionRate; }
+    const std::vector<HydFloat>& linkQuality( void ) const { return m_linkQuality; }
+    const std::vector<LinkStatusOption>& status( void ) const { return m_status; }
+
+private:
+
+    HydTimeSeries( const HydTimeSeries& )=delete;
+
+    HydTimeSeries&
+    operator=( const HydTimeSeries& )=delete;
+
+    int m_numNodes;
+    int m_numLinks;
+    int m_timePoints;
+
+    std::vector<HydFloat> m_pressure;
+    std::vector<HydFloat> m_nodeQuality;
+    std::vector<HydFloat> m_totalHead;
+    std::vector<HydFloat> m_headDeficit;
+    std::vector<HydFloat> m_headExcess;
+    std::vector<HydFloat> m_actualDemand;
+    std::vector<HydFloat> m_netInflow;
+
+    std::vector<HydFloat> m_flow;
+    std::vector<HydFloat> m_velocity;
+    std::vector<HydFloat> m_unitHeadloss;
+    std::vector<HydFloat> m_frictionFactor;
+    std::vector<HydFloat> m_reactionRate;
+    std::vector<HydFloat> m_linkQuality;
+    std::vector<LinkStatusOption> m_status;
+};
+
+#endif
+
+
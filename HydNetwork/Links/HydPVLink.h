@@ -47,9 +47,9 @@ public:
     HydFloat lossCoeff(void) const { return m_lossCoeff; }
     void setLossCoeff(HydFloat loss_coeff) { m_lossCoeff = loss_coeff; }
 
-    const std::vector<HydFloat>& velocity(void) const { return m_velocity; }
+    const HydSeries<HydFloat>& velocity(void) const { return m_velocity; }
     void addVelocity( HydFloat velocity ) { m_velocity.push_back(velocity); }
-    void setVelocity( HydFloat velocity ) { m_velocity = std::vector<HydFloat>(1,velocity); }
+    void setVelocity( HydFloat velocity ) { m_velocity.assign(1,velocity); }
     void setVelocity(const std::vector<HydFloat>& velocity) { m_velocity = velocity; }
     HydFloat maxVelocity(void) const { return *std::max_element(m_velocity.begin(), m_velocity.end()); }
     HydFloat minVelocity(void) const { return *std::min_element(m_velocity.begin(), m_velocity.end()); }
@@ -57,6 +57,13 @@ public:
     HydFloat diameter3DScale(void) const { return m_diameter3DScale; }
     void setDiameter3DScale(HydFloat diameter_3d_scale) { m_diameter3DScale = diameter_3d_scale; }
 
+    void
+    bindSeries(HydTimeSeries& series, int slot) override
+    {
+        HydLink::bindSeries(series, slot);
+        series.bind(m_velocity, series.velocity(), slot);
+    }
+
     //std::vector<bool>& diametersActive(void) { return m_vDiametersActive; }
 
 protected:
@@ -64,7 +71,7 @@ protected:
 	HydFloat m_diameter;
 	HydFloat m_lossCoeff;
     HydFloat m_diameter3DScale;
-	std::vector<HydFloat> m_velocity;
+	HydSeries<HydFloat> m_velocity;
 
     //std::vector<bool>     m_vDiametersActive;
 };
@@ -68,19 +68,19 @@ public:
     HydFloat influence(void) const { return m_influence; }
     void setInfluence(HydFloat influence ) { m_influence = influence; }
     
-    const std::vector<HydFloat>& unitHeadloss(void) const { return m_unitHeadloss; }
+    const HydSeries<HydFloat>& unitHeadloss(void) const { return m_unitHeadloss; }
     void addUnitHeadLoss( HydFloat headLoss ) { m_unitHeadloss.push_back(headLoss); }
-    void setUnitHeadLoss( HydFloat headLoss ) { m_unitHeadloss = std::vector<HydFloat>(1,headLoss); }
+    void setUnitHeadLoss( HydFloat headLoss ) { m_unitHeadloss.assign(1,headLoss); }
     void setUnitHeadLoss(const std::vector<HydFloat>& unit_headloss) { m_unitHeadloss = unit_headloss; }
 	
-    const std::vector<HydFloat>& frictionFactor(void) const { return m_frictionFactor; }
+    const HydSeries<HydFloat>& frictionFactor(void) const { return m_frictionFactor; }
     void setFrictionFactor(const std::vector<HydFloat>& friction_factors) { m_frictionFactor = friction_factors; }
-    void setFrictionFactor(HydFloat friction_factor) { m_frictionFactor = std::vector<HydFloat>(1,friction_factor); }
+    void setFrictionFactor(HydFloat friction_factor) { m_frictionFactor.assign(1,friction_factor); }
     void addFrictionFactor(HydFloat friction_factor) { m_frictionFactor.push_back(friction_factor); }
     
-    const std::vector<HydFloat>& reactionRate(void) const { return m_reactionRate; }
+    const HydSeries<HydFloat>& reactionRate(void) const { return m_reactionRate; }
     void setReactionRate(const std::vector<HydFloat>& reaction_rates) { m_reactionRate = reaction_rates; }
-    void setReactionRate(HydFloat reaction_rates) { m_reactionRate = std::vector<HydFloat>(1,reaction_rates); }
+    void setReactionRate(HydFloat reaction_rates) { m_reactionRate.assign(1,reaction_rates); }
     void addReactionRate(HydFloat reaction_rate) { m_reactionRate.push_back(reaction_rate); }
     
     void setMutationCount(int mutation_count) { m_mutationCount = mutation_count; }
@@ -100,6 +100,15 @@ public:
         m_reactionRate.clear();
     }
     
+    void
+    bindSeries(HydTimeSeries& series, int slot) override
+    {
+        HydPVLink::bindSeries(series, slot);
+        series.bind(m_unitHeadloss, series.unitHeadloss(), slot);
+        series.bind(m_frictionFactor, series.frictionFactor(), slot);
+        series.bind(m_reactionRate, series.reactionRate(), slot);
+    }
+    
 private:
     
 	HydFloat m_length;
@@ -107,9 +116,9 @@ private:
 	HydFloat m_bulkCoeff;
 	HydFloat m_wallCoeff;
     HydFloat m_influence;
-	std::vector<HydFloat> m_unitHeadloss;
-	std::vector<HydFloat> m_frictionFactor;
-	std::vector<HydFloat> m_reactionRate;
+	HydSeries<HydFloat> m_unitHeadloss;
+	HydSeries<HydFloat> m_frictionFactor;
+	HydSeries<HydFloat> m_reactionRate;
 	PipeStatus m_initialStatus;	
     
     int m_mutationCount;
@@ -68,15 +68,17 @@ public:
     HydFloat emitterCoeff(void) const { return m_emitterCoeff; }
     void setEmitterCoeff(HydFloat emitter_coeff) { m_emitterCoeff = emitter_coeff; }
 
-    const std::vector<HydFloat>&  headDeficit(void) const { return m_headDeficit; }
+    const HydSeries<HydFloat>&  headDeficit(void) const { return m_headDeficit; }
     void addHeadDeficit( HydFloat head_deficit ) { m_headDeficit.push_back(head_deficit); }
-    void setHeadDeficit( HydFloat head_deficit ) { m_headDeficit = std::vector<HydFloat>(1, head_deficit); }
+    void setHeadDeficit( HydFloat head_deficit ) { m_headDeficit.assign(1, head_deficit); }
     void setHeadDeficit(const std::vector<HydFloat>& head_deficit) { m_headDeficit = head_deficit; }
+    HydFloat* resizeHeadDeficit( int n ) { return m_headDeficit.resize(n); }
     
-    const std::vector<HydFloat>&  headExcess(void) const { return m_headExcess; }
+    const HydSeries<HydFloat>&  headExcess(void) const { return m_headExcess; }
     void addHeadExcess( HydFloat head_excess ) { m_headExcess.push_back(head_excess); }
-    void setHeadExcess( HydFloat head_excess ) { m_headExcess = std::vector<HydFloat>(1, head_excess); }
+    void setHeadExcess( HydFloat head_excess ) { m_headExcess.assign(1, head_excess); }
     void setHeadExcess(const std::vector<HydFloat>& head_excess) { m_headExcess = head_excess; }
+    HydFloat* resizeHeadExcess( int n ) { return m_headExcess.resize(n); }
     
     const std::vector<HydFloat>& minHead(void) const { return m_minHead; }
     void addMinHead(HydFloat minimum_head) { m_minHead.push_back(minimum_head); }
@@ -86,9 +88,9 @@ public:
     const std::string& demandPattern(void) const { return m_sDemandPatternID; }
     void setDemandPattern(const std::string& demand_pattern_id) { m_sDemandPatternID = demand_pattern_id; }
 
-    const std::vector<HydFloat>&  totalHead(void) const { return m_totalHead; }
+    const HydSeries<HydFloat>&  totalHead(void) const { return m_totalHead; }
     void addTotalHead( HydFloat total_head ) { m_totalHead.push_back(total_head); }
-    void setTotalHead( HydFloat total_head ) { m_totalHead = std::vector<HydFloat>(1, total_head); }
+    void setTotalHead( HydFloat total_head ) { m_totalHead.assign(1, total_head); }
     void setTotalHead(const std::vector<HydFloat>& total_head) { m_totalHead = total_head; }
     HydFloat maxTotalHead(void) const { return *std::max_element(m_totalHead.begin(), m_totalHead.end()); }
     HydFloat minTotalHead(void) const { return *std::min_element(m_totalHead.begin(), m_totalHead.end()); }
@@ -103,9 +105,9 @@ public:
     const std::vector<HydDemandCat>& demandCategories(void) const { return m_vDemandCategories; }
     void removeDemandCategory(int catorgory_index) { m_vDemandCategories.erase(m_vDemandCategories.begin() + catorgory_index); }
     
-    const std::vector<HydFloat>& actualDemand(void) const { return m_actualDemand; }
+    const HydSeries<HydFloat>& actualDemand(void) const { return m_actualDemand; }
     void addActualDemand( HydFloat actual_demand ) { m_actualDemand.push_back(actual_demand); }
-    void setActualDemand( HydFloat actual_demand ) { m_actualDemand = std::vector<HydFloat>(1, actual_demand); }
+    void setActualDemand( HydFloat actual_demand ) { m_actualDemand.assign(1, actual_demand); }
     void setActualDemand(const std::vector<HydFloat>& actual_demand)  { m_actualDemand = actual_demand; }
     
     void
@@ -119,6 +121,16 @@ public:
         m_actualDemand.clear();
     }
     
+    void
+    bindSeries(HydTimeSeries& series, int slot) override
+    {
+        HydNode::bindSeries(series, slot);
+        series.bind(m_headDeficit, series.headDeficit(), slot);
+        series.bind(m_headExcess, series.headExcess(), slot);
+        series.bind(m_totalHead, series.totalHead(), slot);
+        series.bind(m_actualDemand, series.actualDemand(), slot);
+    }
+    
 private:
 
 	HydFloat m_baseElevation;
@@ -127,11 +139,11 @@ private:
 
     std::string m_sDemandPatternID;
     std::vector<HydDemandCat> m_vDemandCategories;
-    std::vector<HydFloat> m_headDeficit;
-    std::vector<HydFloat> m_headExcess;
-    std::vector<HydFloat> m_totalHead;
+    HydSeries<HydFloat> m_headDeficit;
+    HydSeries<HydFloat> m_headExcess;
+    HydSeries<HydFloat> m_totalHead;
     std::vector<HydFloat> m_minHead;
-    std::vector<HydFloat> m_actualDemand;
+    HydSeries<HydFloat> m_actualDemand;
 };
 
 
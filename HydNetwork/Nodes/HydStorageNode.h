@@ -35,15 +35,22 @@ public:
     HydFloat elevation(void) const { return m_elevation; }
     void setElevation(HydFloat elevation) { m_elevation = elevation; }
     
-    const std::vector<HydFloat>& netInflow(void) const { return m_netInflow; }
+    const HydSeries<HydFloat>& netInflow(void) const { return m_netInflow; }
     void setNetInflow(const std::vector<HydFloat>& net_inflow) { m_netInflow = net_inflow; }
     void addNetInflow( HydFloat net_inflow ) { m_netInflow.push_back(net_inflow); }
-    void setNetInflow( HydFloat net_inflow ) { m_netInflow = std::vector<HydFloat>(1,net_inflow); }
+    void setNetInflow( HydFloat net_inflow ) { m_netInflow.assign(1,net_inflow); }
+
+    void
+    bindSeries(HydTimeSeries& series, int slot) override
+    {
+        HydNode::bindSeries(series, slot);
+        series.bind(m_netInflow, series.netInflow(), slot);
+    }
 
 protected:
     
 	HydFloat m_elevation;
-    std::vector<HydFloat> m_netInflow;
+    HydSeries<HydFloat> m_netInflow;
 };
 
 
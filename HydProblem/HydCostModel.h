@@ -0,0 +1,146 @@
+/* HydCostModel 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$$
+ $   HydCostModel.h   $
+ $$$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ The cost of a solution without running a simulation - built by HydProblem::load()
+
+ A flat table holding, for each decision variable dv and each of its options k, the cost of
+ choosing option k, i.e. options[dv].cost(k) * length for a pipe. Row dv starts at offset(dv) so the cost
+ of a solution (a vector of option indexes, one per decision variable, see HHSolution) is a sum of
+ table lookups, and the change in cost between two solutions that differ in k positions is O(k).
+
+ Only pipe decision variables have a cost (as in HydObjective::cost()), other rows are zero.
+ Costs are in the units of the problem file (HydNetwork::cost() holds costs in millions).
+
+*/
+
+
+#ifndef __HYDCOSTMODEL_H__
+#define __HYDCOSTMODEL_H__
+
+#ifndef __HYDTYPES_H__
+#include "HydTypes.h"
+#endif
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cassert>
+
+
+class HydCostModel
+{
+public:
+
+    HydCostModel( void ) : m_offset(1, 0), m_table() {}
+    ~HydCostModel( void )=default;
+
+    void
+    clear( void )
+    {
+        m_offset.assign(1, 0);
+        m_table.clear();
+    }
+
+    // append the row of the next decision variable - the costs of its options multiplied by length
+    // (a length of 0 gives a row of zero costs)
+    void
+    addRow( const std::vector<HydFloat>& costs, HydFloat length )
+    {
+        for (int k = 0; k < costs.size(); ++k)
+            m_table.push_back( (double) costs[k] * length );
+        m_offset.push_back( (int) m_table.size() );
+    }
+
+    // the number of decision variables
+    int
+    size( void ) const { return (int) m_offset.size() - 1; }
+
+    int
+    numOptions( int dv ) const { return m_offset[dv + 1] - m_offset[dv]; }
+
+    int
+    offset( int dv ) const { return m_offset[dv]; }
+
+    // the cost of choosing option k for decision variable dv
+    double
+    cost( int dv, int k ) const { assert(k < numOptions(dv)); return m_table[m_offset[dv] + k]; }
+
+    // the total cost of a solution - O(n)
+    template <typename Solution>
+    double
+    cost( const Solution& solution ) const
+    {
+        assert(solution.size() == size());
+
+        double total = 0.0;
+        for (int dv = 0; dv < solution.size(); ++dv)
+            total += cost(dv, solution[dv]);
+        return total;
+    }
+
+    // the change in cost from base to solution, given the positions at which they differ - O(k)
+    template <typename Solution>
+    double
+    deltaCost( const Solution& base, const Solution& solution, const std::vector<int>& changed ) const
+    {
+        double delta = 0.0;
+        for (int i = 0; i < changed.size(); ++i)
+        {
+            int dv = changed[i];
+            delta += cost(dv, solution[dv]) - cost(dv, base[dv]);
+        }
+        return delta;
+    }
+
+    // the cost of solution, given the cost of base and the positions at which they differ - O(k)
+    template <typename Solution>
+    double
+    cost( double baseCost, const Solution& base, const Solution& solution, const std::vector<int>& changed ) const
+    {
+        return baseCost + deltaCost(base, solution, changed);
+    }
+
+    // the change in cost when decision variable dv changes from option k1 to option k2 - O(1)
+    double
+    deltaCost( int dv, int k1, int k2 ) const { return cost(dv, k2) - cost(dv, k1); }
+
+    // the min and max possible total cost
+    std::pair<double,double>
+    minMaxCost( void ) const
+    {
+        double min_cost = 0.0;
+        double max_cost = 0.0;
+        for (int dv = 0; dv < size(); ++dv)
+        {
+            if (numOptions(dv) == 0)
+                continue;
+
+            double lo = cost(dv, 0);
+            double hi = lo;
+            for (int k = 1; k < numOptions(dv); ++k)
+            {
+                lo = std::min(lo, cost(dv, k));
+                hi = std::max(hi, cost(dv, k));
+            }
+            min_cost += lo;
+            max_cost += hi;
+        }
+        return std::pair<double,double>(min_cost, max_cost);
+    }
+
+private:
+
+    std::vector<int>    m_offset;   /// by decision variable, size() + 1 entries
+    std::vector<double> m_table;    /// cost of each option of each decision variable
+};
+
+#endif
+
+
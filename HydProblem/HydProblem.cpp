@@ -32,6 +32,10 @@
 #include "HydScenarios.h"
 #endif
 
+#ifndef __HYDSNAPSHOT_H__
+#include "HydSnapshot.h"
+#endif
+
 
 extern "C" {
 #include "types.h"
@@ -102,7 +106,11 @@ HydProblem::HydProblem( void ): m_epanet(nullptr),
                                 m_compTypeIdx(),
                                 m_compType(),
                                 m_dvar2spec(),
-                                m_cons2spec()
+                                m_cons2spec(),
+                                m_costModel(),
+                                m_networkText(),
+                                m_useSnapshot(true),
+                                m_fromSnapshot(false)
 {
     m_logger.getLogLevel( "HydProblem" );
 }
@@ -121,7 +129,18 @@ HydProblem::load( const std::string& name )
     
     // i.e  name = "WDNetwork/hanoi";
     // use EPANET to load the network and construct our representation
-    m_hydNet = m_epanet->load( name );
+    if (!HydEPANET::readFile( name, m_networkText ))
+    {
+        if (m_logger.level() >= 1)
+        {
+            Message txt(1);
+            txt << "Unable to read network file " << name;
+            m_logger.logMsg(txt);
+            m_logger.flush();
+        }
+        exit(EXIT_FAILURE);
+    }
+    m_hydNet = m_epanet->load( name, m_networkText );
 
     // load our problem definition
     std::string prb_name = name.substr(0, name.size()-3);
@@ -187,6 +206,8 @@ HydProblem::load( const std::string& name )
     m_hydNet->setOptions(spec.options());
     
     m_hydNet->calculateMinMaxPipeDiameter();
+    
+    buildCostModel();
 
     
     // this is needed for KBH
@@ -244,31 +265,68 @@ HydProblem::load( const std::string& name )
         }
     }
     
-    // set up a mapping from network decision variables (usually pipe_ids) 
-    // to the HHSolution vector indexed [0,...,num_of_dv]
-    // -1 indicated that the network id is not a decsion variable
     int numLinks;
     EN_getcount(m_epanet->getProject(), EN_LINKCOUNT, &numLinks);
-    m_dvar2spec.resize(numLinks + 1, -1);
-    for (int i = 0; i < m_dvariables.size(); ++i)
-        m_dvar2spec[m_dvariables[i].index()] = i;  
-    
-    // set up a mapping from network constraint variables (usually junction_ids) 
-    // to the HOWSProblem vector of constraints  indexed [0,...,num_of_cons]
-    // -1 indicated that the network id is not constrained
     int numNode;
     EN_getcount(m_epanet->getProject(), EN_NODECOUNT, &numNode);
-    m_cons2spec.resize(numNode + 1, -1);
-    for (int i = 0; i < m_constraints.size(); ++i)
-        m_cons2spec[m_constraints[i].index()] = i;  
 
-    // used by HDH
-    calcStaticValues();
+    // a snapshot of a previous load of the same files saves the baseline simulation in calcStaticValues()
+    std::string snap_name = name.substr(0, name.size()-3);
+    snap_name += "snap";
+    
+    std::string prb_text;
+    HydSnapshot snapshot;
+    m_fromSnapshot = m_useSnapshot && HydEPANET::readFile( prb_name, prb_text ) && snapshot.load( snap_name ) &&
+                     snapshot.matches( m_networkText, prb_text, numNode, numLinks, (int) m_dvariables.size(), (int) m_constraints.size() );
+    
+    if (m_fromSnapshot)
+    {
+        m_dvar2spec = snapshot.dvar2spec();
+        m_cons2spec = snapshot.cons2spec();
+        
+        restoreStaticValues( snapshot );
+    }
+    else
+    {
+        // set up a mapping from network decision variables (usually pipe_ids) 
+        // to the HHSolution vector indexed [0,...,num_of_dv]
+        // -1 indicated that the network id is not a decsion variable
+        m_dvar2spec.assign(numLinks + 1, -1);
+        for (int i = 0; i < m_dvariables.size(); ++i)
+            m_dvar2spec[m_dvariables[i].index()] = i;  
+        
+        // set up a mapping from network constraint variables (usually junction_ids) 
+        // to the HOWSProblem vector of constraints  indexed [0,...,num_of_cons]
+        // -1 indicated that the network id is not constrained
+        m_cons2spec.assign(numNode + 1, -1);
+        for (int i = 0; i < m_constraints.size(); ++i)
+            m_cons2spec[m_constraints[i].index()] = i;  
+
+        // used by HDH
+        calcStaticValues();
+        
+        if (m_useSnapshot && !prb_text.empty())
+        {
+            snapshot.setSource( m_networkText, prb_text );
+            snapshot.setSize( numNode, numLinks, (int) m_dvariables.size(), (int) m_constraints.size() );
+            saveStaticValues( snapshot );
+            
+            if (!snapshot.save( snap_name ) && m_logger.level() >= 1)
+            {
+                Message txt(1);
+                txt << "Unable to write snapshot file " << snap_name;
+                m_logger.logMsg(txt);
+                m_logger.flush();
+            }
+        }
+    }
 
     if (m_logger.level() >= 1)
     {
         Message txt(1);
         txt << "Loaded problem file " << prb_name;
+        if (m_fromSnapshot)
+            txt << " (static values from " << snap_name << ")";
         m_logger.logMsg(txt);
         m_logger.flush();
     }
@@ -283,9 +341,8 @@ HydProblem::load( const std::string& name )
 }
 
 void
-HydProblem::calcStaticValues( void )
+HydProblem::setMaxDiameters( void )
 {
-    // set all pipes to max diameter and run simulation
     for (int i = 0; i < m_dvariables.size(); ++i)
     {
         if (m_dvariables[i].hydType() == HydType::Pipe)
@@ -294,6 +351,27 @@ HydProblem::calcStaticValues( void )
             m_epanet->setDiameter( m_dvariables[i].index(), options.max_option() );
         }
     }
+}
+
+void
+HydProblem::buildCostModel( void )
+// see HydObjective::cost() - only pipes have a cost
+{
+    m_costModel.clear();
+    for (int i = 0; i < m_dvariables.size(); ++i)
+    {
+        const HydOptions& options = m_hydNet->options(m_dvariables[i].hydType(), m_dvariables[i].group());
+        const HydPipe* pipe = m_hydNet->findPipe(m_dvariables[i].ID());
+        
+        m_costModel.addRow( options.costs(), (pipe) ? pipe->length() : 0.0 );
+    }
+}
+
+void
+HydProblem::calcStaticValues( void )
+{
+    // set all pipes to max diameter and run simulation
+    setMaxDiameters();
 
     m_epanet->run();
 
@@ -352,6 +430,41 @@ HydProblem::calcStaticValues( void )
     m_hydNet->maxTHeadDeficit( head_deficit );
 }
 
+void
+HydProblem::saveStaticValues( HydSnapshot& snapshot ) const
+{
+    const std::vector<HydPipe*>& pipes = m_hydNet->pipes();
+    for (auto i = pipes.begin(); i != pipes.end(); ++i)
+    {
+        HydPipe* pipe = *i;
+        if (pipe->isDecisionVariable())
+            snapshot.influence()[pipe->index()] = pipe->influence();
+    }
+    
+    snapshot.dvar2spec() = m_dvar2spec;
+    snapshot.cons2spec() = m_cons2spec;
+    snapshot.minTHeadDeficit( m_hydNet->minMaxTHeadDeficit().first );
+    snapshot.maxTHeadDeficit( m_hydNet->minMaxTHeadDeficit().second );
+}
+
+void
+HydProblem::restoreStaticValues( const HydSnapshot& snapshot )
+{
+    // leave EPANET in the same state as calcStaticValues() 
+    setMaxDiameters();
+    
+    const std::vector<HydPipe*>& pipes = m_hydNet->pipes();
+    for (auto i = pipes.begin(); i != pipes.end(); ++i)
+    {
+        HydPipe* pipe = *i;
+        if (pipe->isDecisionVariable())
+            pipe->setInfluence( snapshot.influence()[pipe->index()] );
+    }
+    
+    m_hydNet->minTHeadDeficit( (HydFloat) snapshot.header().minTHeadDeficit );
+    m_hydNet->maxTHeadDeficit( (HydFloat) snapshot.header().maxTHeadDeficit );
+}
+
 //
 
 
@@ -36,6 +36,10 @@
 #include "HydConstraint.h"
 #endif
 
+#ifndef __HYDCOSTMODEL_H__
+#include "HydCostModel.h"
+#endif
+
 #ifndef __LOGGER_H__
 #include "ALogger.h"
 #endif
@@ -47,6 +51,7 @@
 
 class HydEPANET;
 class HydNetwork;
+class HydSnapshot;
 
 class HydProblem
 {
@@ -61,12 +66,26 @@ public:
     HydEPANET*
     getEPANET(void) const { return m_epanet; }
     
+    // load fileName (.inp) and the problem definition (.prb) with the same name
+    // the values derived from them are cached in a snapshot file (.snap) and reused by later loads - see HydSnapshot.h
     void 
     load( const std::string& fileName );
     
+    // enable/disable reading and writing the snapshot file (default enabled)
+    void
+    setSnapshot( bool useSnapshot ) { m_useSnapshot = useSnapshot; }
+    
+    // true if the last load() used a snapshot rather than running the baseline simulation
+    bool
+    fromSnapshot( void ) const { return m_fromSnapshot; }
+    
     HydNetwork* 
     getHydNet(void) const { return m_hydNet; }
     
+    // the contents of the network file read by the last load() - copies of the network are loaded from this
+    const std::string&
+    networkText(void) const { return m_networkText; }
+    
     
     const std::vector<HydDVariable>&
     dvariables(void) const { return m_dvariables;  }        /// applies to link components could be pipes
@@ -89,6 +108,9 @@ public:
     const std::vector<int>&                                  /// map an EPANET node index to a constraint (where possible)
     cons2spec(void) const { return m_cons2spec; }
     
+    const HydCostModel&                                     /// the cost of a solution without simulation
+    costModel(void) const { return m_costModel; }
+    
 private:
 
     HydProblem( const HydProblem& )=delete;
@@ -99,6 +121,18 @@ private:
     void
     calcStaticValues( void );
     
+    void
+    setMaxDiameters( void );
+    
+    void
+    buildCostModel( void );
+    
+    void
+    saveStaticValues( HydSnapshot& snapshot ) const;
+    
+    void
+    restoreStaticValues( const HydSnapshot& snapshot );
+    
     
     HydEPANET* m_epanet;
     HydNetwork* m_hydNet;
@@ -112,6 +146,12 @@ private:
     
     std::vector<int> m_dvar2spec;                   /// map an EPANET index to a solution index (where possible)
     std::vector<int> m_cons2spec;                   /// map an EPANET index to a constraint (where possible)
+    
+    HydCostModel m_costModel;                       /// by decision variable
+    std::string  m_networkText;                     /// the network file as loaded
+
+    bool m_useSnapshot;
+    bool m_fromSnapshot;
 
     mutable Logger m_logger;
 };
@@ -0,0 +1,164 @@
+/* HydSnapshot 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$$$
+ $   HydSnapshot.cpp   $
+ $$$$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+*/
+
+
+#ifndef __HYDSNAPSHOT_H__
+#include "HydSnapshot.h"
+#endif
+
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+
+static const char snapshotMagic[8] = { 'H', 'Y', 'D', 'S', 'N', 'A', 'P', '\0' };
+
+
+HydSnapshot::HydSnapshot( void ) : m_header(), m_dvar2spec(), m_cons2spec(), m_influence()
+{
+    clear();
+}
+
+void
+HydSnapshot::clear( void )
+{
+    std::memset( &m_header, 0, sizeof(Header) );
+    std::memcpy( m_header.magic, snapshotMagic, sizeof(snapshotMagic) );
+    m_header.version   = VERSION;
+    m_header.floatSize = sizeof(HydFloat);
+
+    m_dvar2spec.clear();
+    m_cons2spec.clear();
+    m_influence.clear();
+}
+
+uint64_t
+HydSnapshot::hash( const std::string& text )
+{
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        h ^= (unsigned char) text[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+void
+HydSnapshot::setSource( const std::string& inpText, const std::string& prbText )
+{
+    m_header.inpSize = inpText.size();
+    m_header.inpHash = hash(inpText);
+    m_header.prbSize = prbText.size();
+    m_header.prbHash = hash(prbText);
+}
+
+void
+HydSnapshot::setSize( int numNodes, int numLinks, int numDVariables, int numConstraints )
+{
+    m_header.numNodes       = numNodes;
+    m_header.numLinks       = numLinks;
+    m_header.numDVariables  = numDVariables;
+    m_header.numConstraints = numConstraints;
+
+    m_dvar2spec.assign(numLinks + 1, -1);
+    m_cons2spec.assign(numNodes + 1, -1);
+    m_influence.assign(numLinks + 1, 0.0);
+}
+
+bool
+HydSnapshot::matches( const std::string& inpText, const std::string& prbText,
+                      int numNodes, int numLinks, int numDVariables, int numConstraints ) const
+{
+    return m_header.numNodes == numNodes && m_header.numLinks == numLinks &&
+           m_header.numDVariables == numDVariables && m_header.numConstraints == numConstraints &&
+           m_header.inpSize == inpText.size() && m_header.prbSize == prbText.size() &&
+           m_header.inpHash == hash(inpText) && m_header.prbHash == hash(prbText);
+}
+
+bool
+HydSnapshot::load( const std::string& fileName )
+{
+    clear();
+
+    std::ifstream from( fileName, std::ios::binary );
+    if (!from)
+        return false;
+
+    Header header;
+    if (!from.read( reinterpret_cast<char*>(&header), sizeof(Header) ))
+        return false;
+
+    if (std::memcmp( header.magic, snapshotMagic, sizeof(snapshotMagic) ) != 0 ||
+        header.version != VERSION || header.floatSize != sizeof(HydFloat) ||
+        header.numNodes < 0 || header.numLinks < 0)
+        return false;
+
+    std::vector<int> dvar2spec(header.numLinks + 1);
+    std::vector<int> cons2spec(header.numNodes + 1);
+    std::vector<HydFloat> influence(header.numLinks + 1);
+
+    char pad[8];
+    size_t n1 = dvar2spec.size() * sizeof(int);
+    size_t n2 = cons2spec.size() * sizeof(int);
+    size_t n3 = influence.size() * sizeof(HydFloat);
+
+    from.read( reinterpret_cast<char*>(dvar2spec.data()), n1 );
+    from.read( pad, padding(n1) );
+    from.read( reinterpret_cast<char*>(cons2spec.data()), n2 );
+    from.read( pad, padding(n2) );
+    from.read( reinterpret_cast<char*>(influence.data()), n3 );
+
+    if (!from)
+        return false;
+
+    m_header = header;
+    m_dvar2spec.swap(dvar2spec);
+    m_cons2spec.swap(cons2spec);
+    m_influence.swap(influence);
+    return true;
+}
+
+bool
+HydSnapshot::save( const std::string& fileName ) const
+{
+    // write to a temporary file and rename it so a concurrent load never sees a partial snapshot
+    std::string tmpName = fileName + ".tmp";
+
+    std::ofstream to( tmpName, std::ios::binary | std::ios::trunc );
+    if (!to)
+        return false;
+
+    const char pad[8] = { 0 };
+    size_t n1 = m_dvar2spec.size() * sizeof(int);
+    size_t n2 = m_cons2spec.size() * sizeof(int);
+    size_t n3 = m_influence.size() * sizeof(HydFloat);
+
+    to.write( reinterpret_cast<const char*>(&m_header), sizeof(Header) );
+    to.write( reinterpret_cast<const char*>(m_dvar2spec.data()), n1 );
+    to.write( pad, padding(n1) );
+    to.write( reinterpret_cast<const char*>(m_cons2spec.data()), n2 );
+    to.write( pad, padding(n2) );
+    to.write( reinterpret_cast<const char*>(m_influence.data()), n3 );
+    to.close();
+
+    if (!to || std::rename( tmpName.c_str(), fileName.c_str() ) != 0)
+    {
+        std::remove( tmpName.c_str() );
+        return false;
+    }
+    return true;
+}
+
+//
+
+
@@ -0,0 +1,138 @@
+/* HydSnapshot 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$
+ $   HydSnapshot.h   $
+ $$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ A binary cache of the values HydProblem::load() derives from a network (.inp) and problem (.prb) file,
+ so that later loads of the same files can skip the max-diameter baseline simulation - see HydProblem::calcStaticValues()
+
+ The snapshot holds the dvar2spec/cons2spec mappings, the influence of each decision pipe and the theoretical
+ min/max head deficit. It is only used if the size and hash of both text files, and the number of nodes, links,
+ decision variables and constraints, match those recorded when it was written.
+
+ The file is a fixed layout image - a header followed by arrays, each starting on an 8 byte boundary -
+ written in native byte order, so it could be memory mapped. It is not portable between machines with
+ different byte orders or HydFloat sizes (these fail validation and the snapshot is rebuilt).
+
+   Header
+   int32    dvar2spec[numLinks + 1]
+   int32    cons2spec[numNodes + 1]
+   HydFloat influence[numLinks + 1]     /// indexed by EPANET link index, 0 if not a decision pipe
+
+*/
+
+
+#ifndef __HYDSNAPSHOT_H__
+#define __HYDSNAPSHOT_H__
+
+#ifndef __HYDTYPES_H__
+#include "HydTypes.h"
+#endif
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+class HydSnapshot
+{
+public:
+
+    // increment when the layout or meaning of the snapshot changes
+    static const uint32_t VERSION = 1;
+
+    struct Header
+    {
+        char     magic[8];          /// "HYDSNAP"
+        uint32_t version;
+        uint32_t floatSize;         /// sizeof(HydFloat)
+        uint64_t inpSize;
+        uint64_t inpHash;
+        uint64_t prbSize;
+        uint64_t prbHash;
+        int32_t  numNodes;
+        int32_t  numLinks;
+        int32_t  numDVariables;
+        int32_t  numConstraints;
+        double   minTHeadDeficit;
+        double   maxTHeadDeficit;
+    };
+
+    HydSnapshot( void );
+    ~HydSnapshot( void )=default;
+
+    void
+    clear( void );
+
+    // record the text of the network and problem files the snapshot is derived from
+    void
+    setSource( const std::string& inpText, const std::string& prbText );
+
+    void
+    setSize( int numNodes, int numLinks, int numDVariables, int numConstraints );
+
+    // read a snapshot - returns false if the file cannot be read or is not a valid snapshot
+    bool
+    load( const std::string& fileName );
+
+    // returns false if the file cannot be written
+    bool
+    save( const std::string& fileName ) const;
+
+    // true if this snapshot was derived from the given files and network size
+    bool
+    matches( const std::string& inpText, const std::string& prbText,
+             int numNodes, int numLinks, int numDVariables, int numConstraints ) const;
+
+    // 64 bit FNV-1a
+    static uint64_t
+    hash( const std::string& text );
+
+    const Header&
+    header( void ) const { return m_header; }
+
+    std::vector<int>&
+    dvar2spec( void ) { return m_dvar2spec; }
+
+    std::vector<int>&
+    cons2spec( void ) { return m_cons2spec; }
+
+    std::vector<HydFloat>&
+    influence( void ) { return m_influence; }
+
+    const std::vector<int>&
+    dvar2spec( void ) const { return m_dvar2spec; }
+
+    const std::vector<int>&
+    cons2spec( void ) const { return m_cons2spec; }
+
+    const std::vector<HydFloat>&
+    influence( void ) const { return m_influence; }
+
+    void
+    minTHeadDeficit( HydFloat minTHead ) { m_header.minTHeadDeficit = minTHead; }
+
+    void
+    maxTHeadDeficit( HydFloat maxTHead ) { m_header.maxTHeadDeficit = maxTHead; }
+
+private:
+
+    // bytes written after an array of n bytes to reach an 8 byte boundary
+    static int
+    padding( size_t n ) { return (int) ((8 - (n % 8)) % 8); }
+
+    Header m_header;
+
+    std::vector<int>      m_dvar2spec;
+    std::vector<int>      m_cons2spec;
+    std::vector<HydFloat> m_influence;
+};
+
+#endif
+
+
@@ -99,6 +99,7 @@ to_json(Json& json, const OptimiseMessage& msg)
     json["msgtype"]    = msg.msgType();
     json["iterations"] = msg.iters();
     json["seed"]       = msg.seed();
+    json["seconds"]    = msg.seconds();
     json["obj_type"]   = msg.objFuncType();
     json["obj_params"] = msg.objFuncParams();
     json["llhs"]       = msg.llhs();
@@ -111,6 +112,7 @@ from_json(const Json& json, OptimiseMessage& msg)
     msg.msgType(json.at("msgtype").get<std::string>());
     msg.iters(json.at("iterations").get<int>());
     msg.seed(json.at("seed").get<int>());
+    msg.seconds(json.value("seconds", 0.0));   // optional
     msg.objFuncType(json.at("obj_type").get<int>());
     msg.objFuncParams(json.at("obj_params").get<std::vector<ObjType>>());
     msg.llhs(json.at("llhs").get<std::vector<int>>());
@@ -916,6 +918,8 @@ HydJSON::buildNetwork( const Json& json, HydNetwork* hydNet )
     addComponent<HydTank>("tanks", HydType::Tank, json, hydNet);
     addComponent<HydPump>("pumps", HydType::Pump, json, hydNet);
     addComponent<HydValve>("valves", HydType::Valve, json, hydNet);
+    
+    hydNet->buildIncidence();
 
     return true;
 }
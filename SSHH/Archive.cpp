@@ -23,17 +23,62 @@
 #include "Archive.h"
 #endif
 
+#include <climits>
 #include <assert.h>
 
 #ifndef __UTILS_H__
 #include "AUtils.h"
 #endif
 
+#ifndef __HHSOLUTIONOPS_H__
+#include "HHSolutionOps.h"
+#endif
+
+#ifndef __HHBINARY_H__
+#include "HHBinary.h"
+#endif
+
 void
 Archive::clear( void )
 {
     m_objVals.clear(); 
     m_archive.clear();
+    m_hashes.clear();
+}
+
+void
+Archive::write( std::ostream& ostr ) const
+{
+    HHBinary::write(ostr, (uint64_t) m_archive.size());
+    for (int i = 0; i < m_archive.size(); ++i)
+    {
+        HHBinary::write(ostr, m_archive[i]);
+        HHBinary::write(ostr, m_objVals[i]);
+    }
+}
+
+bool
+Archive::read( std::istream& istr )
+{
+    clear();
+    
+    uint64_t n = 0;
+    if (!HHBinary::read(istr, n) || n > INT_MAX || !HHBinary::fits(istr, n, 2 * sizeof(uint64_t)))
+        return false;
+    
+    m_archive.resize(n);
+    m_objVals.resize(n);
+    m_hashes.resize(n);
+    for (int i = 0; i < m_archive.size(); ++i)
+    {
+        if (!HHBinary::read(istr, m_archive[i]) || !HHBinary::read(istr, m_objVals[i]))
+        {
+            clear();
+            return false;
+        }
+        m_hashes[i] = HHSolutionOps::hash(m_archive[i]);
+    }
+    return true;
 }
 
 bool
@@ -56,6 +101,19 @@ Archive::dominates(const HHObjective& obj_x, const HHObjective& obj_y) const
     return any;
 }
 
+bool
+Archive::nondominated( void ) const
+{
+    for (int i = 0; i < m_objVals.size(); ++i)
+    {
+        for (int j = 0; j < m_objVals.size(); ++j)
+        {
+            if (i != j && dominates( m_objVals[i], m_objVals[j] ))
+                return false;
+        }
+    }
+    return true;
+}
 
 std::vector<ObjType>
 Archive::max( void ) const
@@ -81,10 +139,11 @@ Archive::max( void ) const
 bool
 Archive::update(const HHSolution& sol, const HHObjective& objVal, int iter )
 {
-    // Ensure that the solution does not already exist in the archive.
+    // Ensure that the solution does not already exist in the archive (only solutions with the same hash are compared).
+    const uint64_t hash = HHSolutionOps::hash(sol);
     for (int i = 0; i < m_archive.size(); ++i)
     {
-        if (m_archive[i] == sol)
+        if (m_hashes[i] == hash && HHSolutionOps::equal(m_archive[i], sol))
             return false;
     }
     
@@ -102,18 +161,21 @@ Archive::update(const HHSolution& sol, const HHObjective& objVal, int iter )
         // the archive which are dominated by the new solution.
         std::vector<HHSolution>  archive(1, sol);
         std::vector<HHObjective> objVals(1, objVal);
+        std::vector<uint64_t>    hashes(1, hash);
         
         for (int i = 0; i < m_objVals.size(); ++i)
         {
             if (!dominates( objVal, m_objVals[i] ))
             {
-                archive.push_back(m_archive[i]);
+                archive.push_back(std::move(m_archive[i]));
                 objVals.push_back(m_objVals[i]);
+                hashes.push_back(m_hashes[i]);
             }
         } 
         
-        m_archive = archive;
-        m_objVals = objVals;
+        m_archive.swap(archive);
+        m_objVals.swap(objVals);
+        m_hashes.swap(hashes);
         
         return true;
     }
@@ -30,6 +30,8 @@
 #include "AMatrix.h"
 #endif
 
+#include <cstdint>
+#include <iostream>
 #include <vector>
 
 
@@ -38,7 +40,7 @@ class Archive
 {
 public:
     
-    Archive( void ): m_archive(), m_objVals() {}
+    Archive( void ): m_objVals(), m_archive(), m_hashes() {}
     ~Archive( void )=default;
      
     bool
@@ -59,10 +61,18 @@ public:
     int
     size( void ) const { return (int) m_archive.size(); }
     
+    // the same solutions with the same objective function values in the same order - see SSHH::checkSpeculation()
+    bool
+    operator==( const Archive& other ) const { return m_archive == other.m_archive && m_objVals == other.m_objVals; }
+    
     // does obj1 dominate obj2? (assume less than as we are minimizing)
     bool
     dominates( const HHObjective& obj1, const HHObjective& obj2 ) const;
     
+    // does no archived value dominate another? - see SSHHIslands::selfCheck()
+    bool
+    nondominated( void ) const;
+    
     
     std::vector<ObjType>
     max( void ) const;
@@ -70,10 +80,18 @@ public:
     std::vector<double>
     crowding( void ) const;
     
+    // write/read the archived solutions and objective values in binary - see SSHH::checkpoint
+    void
+    write( std::ostream& ostr ) const;
+    
+    bool
+    read( std::istream& istr );
+    
 private:
     
     std::vector<HHObjective> m_objVals; 
     std::vector<HHSolution>  m_archive;
+    std::vector<uint64_t>    m_hashes;      /// HHSolutionOps::hash() of each archived solution
 
 };
 
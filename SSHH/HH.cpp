@@ -106,7 +106,7 @@ HH::finalLogReturn( void ) const
     if (m_history.empty())
         return 0.0;
 
-    return logRet( m_best_obj, m_history[0].cur_obj() );
+    return logRet( m_best_obj, m_history.first().cur_obj() );
 }
 
 
@@ -116,7 +116,7 @@ HH::finalDecimalReturn( void ) const
     if (m_history.empty())
         return 0.0;
 
-    return decRet(m_best_obj, m_history[0].cur_obj());
+    return decRet(m_best_obj, m_history.first().cur_obj());
 }
 
 
@@ -150,7 +150,6 @@ HH::beginRunLog( void )
 
     m_llh_start = m_llh_finish = 0;
     m_history.clear();
-    m_history.reserve(150);
     
     if (m_logger.level() >= 3)
     {
@@ -175,7 +174,7 @@ HH::updateRunLog( int llh, int param, int accepted, double cur_obj, double new_o
     if (m_logger.level() >= 3)
     {
         Message txt(3);
-        txt << m_history.size() - 1 << '\t' << s;
+        txt << m_history.total() - 1 << '\t' << s;
         m_logger.logMsg(txt);
         m_logger.flush();
     }
@@ -187,9 +186,18 @@ HH::endRunLog( void )
 {
     m_finish = std::time(0);
     
+    // write the rest of the run history if it is streamed
+    if (m_history.streaming() && !m_history.closeStream() && m_logger.level() >= 1)
+    {
+        Message txt(1);
+        txt << "Could not write the run history stream";
+        m_logger.logMsg(txt);
+        m_logger.flush();
+    }
+    
     if (m_logger.level() >= 1)
     {
-        double initial_obj = m_history[0].cur_obj();
+        double initial_obj = m_history.first().cur_obj();
         double lr = finalLogReturn();
         int    dp = 4;
         
@@ -20,8 +20,8 @@
 #ifndef __HH_H__
 #define __HH_H__
 
-#ifndef __HHSTATE_H__
-#include "HHState.h"
+#ifndef __HHHISTORY_H__
+#include "HHHistory.h"
 #endif
 
 #ifndef __HHPROBLEM_H__
@@ -86,7 +86,7 @@ public:
     
     /// The initial objective function value
     double
-    initialObj( void ) const { return (!m_history.empty()) ? m_history[0].cur_obj() : 0.0; }
+    initialObj( void ) const { return (!m_history.empty()) ? m_history.first().cur_obj() : 0.0; }
 
     /// The besy objective function value
     double
@@ -112,10 +112,21 @@ public:
     int
     bestIter( void ) const { return m_best_iter; }
     
-    /// Get the run history
-    const std::vector<HHState>&
+    /// Get the run history (the last historySize() states, see HHHistory)
+    const HHHistory&
     history( void ) const { return m_history; }
 
+    /// Keep the last n states of the run history in memory (default 4096)
+    void
+    historySize( int n ) { m_history.setCapacity(n); }
+
+    int
+    historySize( void ) const { return m_history.capacity(); }
+
+    /// Stream every state of the run history to a binary file on a background thread (see HHHistory::load)
+    bool
+    streamHistory( const std::string& fileName ) { return m_history.openStream(fileName); }
+
     virtual void
     logProblem( int iterations );
 
@@ -152,7 +163,7 @@ protected:
     std::vector<int> m_heuristics;
     std::vector<int> m_usage;
     std::vector<std::string> m_llhNames;
-    std::vector<HHState> m_history;
+    HHHistory m_history;
     
     HHObjFunc m_toScalar;    //!< Combines the objective values into a single value 
 
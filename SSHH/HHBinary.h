@@ -0,0 +1,140 @@
+/* HHBinary 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$
+ $   HHBinary.h   $
+ $$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ Binary read and write of plain values, vectors and matrices - used by the checkpoint files of SSHH (see SSHH::checkpoint())
+
+ Values are written in the machine's native representation (a checkpoint is resumed on the machine, or at least
+ the architecture, that wrote it). A vector is written as its 64 bit size followed by its elements, a matrix as
+ its rows and columns followed by its elements. read() returns false if the stream fails, or if a size read from the
+ stream is more than the rest of the stream could hold (see fits()) - nothing is allocated for a corrupt size.
+
+*/
+
+
+#ifndef __HHBINARY_H__
+#define __HHBINARY_H__
+
+#ifndef __MATRIX_H__
+#include "AMatrix.h"
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <type_traits>
+
+
+class HHBinary
+{
+public:
+
+    template <typename T>
+    static void
+    write( std::ostream& ostr, const T& x )
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "HHBinary::write - not a plain value");
+        ostr.write( reinterpret_cast<const char*>(&x), sizeof(T) );
+    }
+
+    template <typename T>
+    static bool
+    read( std::istream& istr, T& x )
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "HHBinary::read - not a plain value");
+        return (bool) istr.read( reinterpret_cast<char*>(&x), sizeof(T) );
+    }
+
+    template <typename T>
+    static void
+    write( std::ostream& ostr, const std::vector<T>& v )
+    {
+        write(ostr, (uint64_t) v.size());
+        if constexpr (std::is_trivially_copyable<T>::value)
+            ostr.write( reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T) );
+        else
+        {
+            for (size_t i = 0; i < v.size(); ++i)
+                write(ostr, v[i]);
+        }
+    }
+
+    template <typename T>
+    static bool
+    read( std::istream& istr, std::vector<T>& v )
+    {
+        uint64_t n = 0;
+        if (!read(istr, n) || n > MAX_SIZE || !fits(istr, n, (std::is_trivially_copyable<T>::value) ? sizeof(T) : 1))
+            return false;
+
+        v.resize(n);
+        if constexpr (std::is_trivially_copyable<T>::value)
+            return (bool) istr.read( reinterpret_cast<char*>(v.data()), n * sizeof(T) );
+        else
+        {
+            for (size_t i = 0; i < n; ++i)
+                if (!read(istr, v[i]))
+                    return false;
+            return true;
+        }
+    }
+
+    template <typename T>
+    static void
+    write( std::ostream& ostr, const Matrix<T>& m )
+    {
+        write(ostr, (int32_t) m.rows());
+        write(ostr, (int32_t) m.cols());
+        for (int i = 0; i < m.rows(); ++i)
+            ostr.write( reinterpret_cast<const char*>(m[i].data()), m.cols() * sizeof(T) );
+    }
+
+    template <typename T>
+    static bool
+    read( std::istream& istr, Matrix<T>& m )
+    {
+        int32_t rows = 0, cols = 0;
+        if (!read(istr, rows) || !read(istr, cols) || rows < 0 || cols < 0 || !fits(istr, (uint64_t) rows * cols, sizeof(T)))
+            return false;
+
+        m.clear();
+        m.resize(rows, cols, T());
+        for (int i = 0; i < rows; ++i)
+            if (!istr.read( reinterpret_cast<char*>(m[i].data()), cols * sizeof(T) ))
+                return false;
+        return true;
+    }
+
+    // false if the rest of the stream is shorter than n elements of (at least) bytes bytes each - check a count
+    // read from the stream before sizing a container with it (true if the stream cannot report its length)
+    static bool
+    fits( std::istream& istr, uint64_t n, uint64_t bytes )
+    {
+        const std::streampos pos = istr.tellg();
+        if (pos == std::streampos(-1))
+            return true;
+
+        istr.seekg(0, std::ios::end);
+        const std::streampos end = istr.tellg();
+        istr.seekg(pos);
+        if (end == std::streampos(-1) || !istr)
+            return true;
+
+        return n <= (uint64_t) (end - pos) / std::max<uint64_t>(bytes, 1);
+    }
+
+private:
+
+    static constexpr uint64_t MAX_SIZE = 1ULL << 32;   /// guards against reading a corrupt size
+};
+
+#endif
+
+
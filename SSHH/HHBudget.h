@@ -0,0 +1,101 @@
+/* HHBudget 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$
+ $   HHBudget.h   $
+ $$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ The budget of a hyper-heuristic run - see SSHH::solve( const HHBudget& )
+
+ A run stops when any of its limits is reached: a number of iterations, a number of objective function
+ evaluations, a number of iterations without an improvement of the best objective value (stagnation), or
+ a wall clock time in seconds. A limit < 0 is not used. The clock is only read every CLOCK_INTERVAL iterations
+ so checking the budget costs a few integer comparisons per iteration.
+
+ Example - the best design within 20 seconds, or after 100000 iterations
+
+ HHBudget budget(100000);
+ budget.setSeconds(20.0);
+ sshh.solve(budget);
+
+*/
+
+
+#ifndef __HHBUDGET_H__
+#define __HHBUDGET_H__
+
+#include <chrono>
+
+
+class HHBudget
+{
+public:
+
+    enum Limit { NONE = 0, ITERATIONS = 1, EVALUATIONS = 2, STAGNATION = 3, TIME = 4 };
+
+    HHBudget( void ) : m_iterations(-1), m_evaluations(-1), m_stagnation(-1), m_seconds(-1.0), m_start() {}
+    explicit HHBudget( int iterations ) : m_iterations(iterations), m_evaluations(-1), m_stagnation(-1), m_seconds(-1.0), m_start() {}
+    ~HHBudget( void )=default;
+
+    void setIterations( int n ) { m_iterations = n; }
+    void setEvaluations( int n ) { m_evaluations = n; }
+    void setStagnation( int n ) { m_stagnation = n; }
+    void setSeconds( double s ) { m_seconds = s; }
+
+    int iterations( void ) const { return m_iterations; }
+    int evaluations( void ) const { return m_evaluations; }
+    int stagnation( void ) const { return m_stagnation; }
+    double seconds( void ) const { return m_seconds; }
+
+    // is there at least one limit
+    bool
+    limited( void ) const { return m_iterations >= 0 || m_evaluations >= 0 || m_stagnation >= 0 || m_seconds >= 0.0; }
+
+    // start the clock
+    void
+    start( void ) { m_start = std::chrono::steady_clock::now(); }
+
+    // the seconds since start()
+    double
+    elapsed( void ) const { return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count(); }
+
+    // the limit reached after iterations and evaluations in this run, and stagnant iterations since the last improvement
+    Limit
+    exhausted( int iterations, int evaluations, int stagnant ) const
+    {
+        if (m_iterations >= 0 && iterations >= m_iterations)
+            return ITERATIONS;
+        if (m_evaluations >= 0 && evaluations >= m_evaluations)
+            return EVALUATIONS;
+        if (m_stagnation >= 0 && stagnant >= m_stagnation)
+            return STAGNATION;
+        if (m_seconds >= 0.0 && iterations % CLOCK_INTERVAL == 0 && elapsed() >= m_seconds)
+            return TIME;
+        return NONE;
+    }
+
+    static const char*
+    name( Limit l )
+    {
+        static const char* names[] = { "none", "iterations", "evaluations", "stagnation", "time" };
+        return names[l];
+    }
+
+private:
+
+    enum { CLOCK_INTERVAL = 16 };
+
+    int    m_iterations;
+    int    m_evaluations;
+    int    m_stagnation;
+    double m_seconds;
+
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#endif
+
+
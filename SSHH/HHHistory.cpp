@@ -0,0 +1,282 @@
+/* HHHistory 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$
+ $   HHHistory.cpp   $
+ $$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+*/
+
+
+#ifndef __HHHISTORY_H__
+#include "HHHistory.h"
+#endif
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <assert.h>
+
+
+// the stream file format - increment STREAM_VERSION when the record layout changes
+static const char     STREAM_MAGIC[8] = { 'H', 'H', 'R', 'U', 'N', 'L', 'O', 'G' };
+static const uint32_t STREAM_VERSION  = 1;
+
+
+HHHistory::HHHistory( int capacity ): m_ring(std::max(1, capacity)),
+                                      m_head(0),
+                                      m_size(0),
+                                      m_total(0),
+                                      m_streamed(0),
+                                      m_first(),
+                                      m_file(),
+                                      m_buffer(),
+                                      m_writer(),
+                                      m_queue(),
+                                      m_stop(false) {}
+
+HHHistory::~HHHistory( void )
+{
+    closeStream();
+}
+
+void
+HHHistory::clear( void )
+{
+    flush();
+    
+    m_head     = 0;
+    m_size     = 0;
+    m_total    = 0;
+    m_streamed = 0;
+    m_first    = HHState();
+}
+
+void
+HHHistory::resume( const HHState& first, long total )
+{
+    clear();
+    
+    m_first    = first;
+    m_total    = total;
+    m_streamed = total;
+}
+
+void
+HHHistory::push_back( const HHState& s )
+{
+    const int cap = capacity();
+    
+    if (m_size == cap)
+    {
+        // the oldest state leaves the ring
+        if (streaming() && index(0) >= m_streamed)
+        {
+            stream(0);
+            m_streamed = index(0) + 1;
+        }
+        m_ring[m_head] = s;
+        m_head = (m_head + 1) % cap;
+    }
+    else
+    {
+        m_ring[(m_head + m_size) % cap] = s;
+        ++m_size;
+    }
+    
+    if (m_total == 0)
+        m_first = s;
+    ++m_total;
+}
+
+void
+HHHistory::setCapacity( int n )
+{
+    assert(n > 0);
+    
+    if (n == capacity())
+        return;
+    
+    // the oldest states that no longer fit are streamed first
+    const int keep = std::min(n, m_size);
+    for (int i = 0; i < m_size - keep; ++i)
+    {
+        if (streaming() && index(i) >= m_streamed)
+        {
+            stream(i);
+            m_streamed = index(i) + 1;
+        }
+    }
+    
+    std::vector<HHState> ring(n);
+    for (int i = 0; i < keep; ++i)
+        ring[i] = (*this)[m_size - keep + i];
+    
+    m_ring.swap(ring);
+    m_head = 0;
+    m_size = keep;
+}
+
+bool
+HHHistory::openStream( const std::string& fileName )
+{
+    closeStream();
+    
+    m_file.open( fileName, std::ios::binary | std::ios::trunc );
+    if (!m_file)
+        return false;
+    
+    m_file.write(STREAM_MAGIC, sizeof(STREAM_MAGIC));
+    m_file.write(reinterpret_cast<const char*>(&STREAM_VERSION), sizeof(STREAM_VERSION));
+    
+    // the states held are written too
+    m_streamed = m_total - m_size;
+    m_stop     = false;
+    m_buffer.clear();
+    m_buffer.reserve(BUFFER_SIZE);
+    
+    m_writer = std::thread( &HHHistory::writer, this );
+    return true;
+}
+
+bool
+HHHistory::closeStream( void )
+{
+    if (!streaming())
+        return true;
+    
+    flush();
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_ready.notify_one();
+    m_writer.join();
+    
+    const bool ok = (bool) m_file;
+    m_file.close();
+    m_stop = false;
+    
+    return ok;
+}
+
+void
+HHHistory::flush( void )
+{
+    if (!streaming())
+        return;
+    
+    for (int i = 0; i < m_size; ++i)
+    {
+        if (index(i) >= m_streamed)
+            stream(i);
+    }
+    m_streamed = m_total;
+    
+    queueBuffer();
+}
+
+void
+HHHistory::stream( int i )
+{
+    // index, llh, param, htype, accepted, duration, cur_obj, new_obj
+    const HHState& s = (*this)[i];
+    const uint32_t idx      = (uint32_t) index(i);
+    const uint8_t  bytes[4] = { (uint8_t) s.llh(), (uint8_t) s.param(), (uint8_t) s.htype(), (uint8_t) s.accepted() };
+    const int32_t  ticks    = (int32_t) (s.finish() - s.start());
+    const double   cur_obj  = s.cur_obj();
+    const double   new_obj  = s.new_obj();
+    
+    char record[RECORD_SIZE];
+    std::memcpy(record,      &idx,     4);
+    std::memcpy(record + 4,  bytes,    4);
+    std::memcpy(record + 8,  &ticks,   4);
+    std::memcpy(record + 12, &cur_obj, 8);
+    std::memcpy(record + 20, &new_obj, 8);
+    
+    m_buffer.insert(m_buffer.end(), record, record + RECORD_SIZE);
+    
+    if (m_buffer.size() >= BUFFER_SIZE)
+        queueBuffer();
+}
+
+void
+HHHistory::queueBuffer( void )
+{
+    if (m_buffer.empty())
+        return;
+    
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_space.wait( lock, [this]( void ) { return m_queue.size() < MAX_BUFFERS; } );
+        m_queue.push_back( std::move(m_buffer) );
+    }
+    m_ready.notify_one();
+    
+    m_buffer = std::vector<char>();
+    m_buffer.reserve(BUFFER_SIZE);
+}
+
+void
+HHHistory::writer( void )
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    
+    for (;;)
+    {
+        m_ready.wait( lock, [this]( void ) { return !m_queue.empty() || m_stop; } );
+        if (m_queue.empty())
+            break;
+        
+        std::vector<char> buffer = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_space.notify_one();
+        
+        lock.unlock();
+        m_file.write(buffer.data(), buffer.size());
+        lock.lock();
+    }
+}
+
+bool
+HHHistory::load( const std::string& fileName, std::vector<Record>& records )
+{
+    records.clear();
+    
+    std::ifstream from( fileName, std::ios::binary );
+    
+    char magic[sizeof(STREAM_MAGIC)];
+    uint32_t version = 0;
+    if (!from.read(magic, sizeof(magic)) || std::memcmp(magic, STREAM_MAGIC, sizeof(magic)) != 0 ||
+        !from.read(reinterpret_cast<char*>(&version), sizeof(version)) || version != STREAM_VERSION)
+        return false;
+    
+    char record[RECORD_SIZE];
+    while (from.read(record, RECORD_SIZE))
+    {
+        uint32_t idx = 0;
+        uint8_t  bytes[4];
+        int32_t  ticks = 0;
+        double   cur_obj = 0.0, new_obj = 0.0;
+        
+        std::memcpy(&idx,     record,      4);
+        std::memcpy(bytes,    record + 4,  4);
+        std::memcpy(&ticks,   record + 8,  4);
+        std::memcpy(&cur_obj, record + 12, 8);
+        std::memcpy(&new_obj, record + 20, 8);
+        
+        Record r;
+        r.index = idx;
+        r.state = HHState(bytes[0], bytes[1], (char) bytes[2], (char) bytes[3], 0, ticks, cur_obj, new_obj);
+        records.push_back(r);
+    }
+    
+    // a partial record means a truncated file
+    return from.gcount() == 0;
+}
+
+//
@@ -0,0 +1,173 @@
+/* HHHistory 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$
+ $   HHHistory.h   $
+ $$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ The run log of a hyper-heuristic - a ring buffer of the last capacity() HHStates with optional streaming to a file
+
+ Memory use is fixed by the capacity (default 4096 states) however long the run. The first state of the run
+ (the initial objective value) is always kept - see first(). Entry i is the i-th oldest state still held, and
+ index(i) its position in the run.
+
+ If a stream is open every state is written to a compact binary file (28 bytes per state) when it leaves the
+ ring buffer, or on flush(), so a state's acceptance decision is usually final by the time it is written. The file
+ is written on a background thread through a bounded queue of buffers, so streaming costs the run a copy per state
+ and never more than a few hundred kilobytes of memory. load() reads a stream back.
+
+ Example
+
+ sshh.streamHistory("run.hhlog");
+ sshh.solve(1000000);
+ sshh.endRunLog();
+
+ std::vector<HHHistory::Record> records;
+ HHHistory::load("run.hhlog", records);
+
+*/
+
+
+#ifndef __HHHISTORY_H__
+#define __HHHISTORY_H__
+
+#ifndef __HHSTATE_H__
+#include "HHState.h"
+#endif
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+class HHHistory
+{
+public:
+
+    // a state read from a stream - the times of a streamed state are relative (start is 0)
+    struct Record
+    {
+        long    index;      //!< The position of the state in the run
+        HHState state;
+    };
+
+    explicit HHHistory( int capacity = DEFAULT_CAPACITY );
+    ~HHHistory( void );
+
+    // remove all states (those not yet streamed are written first)
+    void
+    clear( void );
+
+    void
+    push_back( const HHState& s );
+
+    // clear() and continue a run whose first state was first and which has had total states so far
+    // without holding them (see SSHH::restore)
+    void
+    resume( const HHState& first, long total );
+
+    // the number of states held
+    int
+    size( void ) const { return m_size; }
+
+    bool
+    empty( void ) const { return m_total == 0; }
+
+    // the number of states in the run so far
+    long
+    total( void ) const { return m_total; }
+
+    // the position in the run of the i-th held state
+    long
+    index( int i ) const { return m_total - m_size + i; }
+
+    const HHState&
+    operator[]( int i ) const { return m_ring[(m_head + i) % m_ring.size()]; }
+
+    HHState&
+    operator[]( int i ) { return m_ring[(m_head + i) % m_ring.size()]; }
+
+    const HHState&
+    back( void ) const { return (*this)[m_size - 1]; }
+
+    // the first state of the run
+    const HHState&
+    first( void ) const { return m_first; }
+
+    // keep the last n states, n > 0
+    void
+    setCapacity( int n );
+
+    int
+    capacity( void ) const { return (int) m_ring.size(); }
+
+    // stream every state to fileName from now on (closes any open stream)
+    bool
+    openStream( const std::string& fileName );
+
+    // write the held states not yet streamed, then stop the background writer
+    // returns false if the stream could not be written
+    bool
+    closeStream( void );
+
+    bool
+    streaming( void ) const { return m_writer.joinable(); }
+
+    // hand the held states not yet streamed to the background writer
+    void
+    flush( void );
+
+    // read a stream written by openStream()
+    static bool
+    load( const std::string& fileName, std::vector<Record>& records );
+
+private:
+
+    HHHistory( const HHHistory& )=delete;
+
+    HHHistory&
+    operator=( const HHHistory& )=delete;
+
+    static constexpr int DEFAULT_CAPACITY = 4096;
+    static constexpr int RECORD_SIZE      = 28;           /// bytes per streamed state
+    static constexpr int BUFFER_SIZE      = 64 * 1024;    /// bytes handed to the writer at a time
+    static constexpr int MAX_BUFFERS      = 8;            /// buffers queued before push_back() waits for the writer
+
+    // append the held state i to the stream buffer
+    void
+    stream( int i );
+
+    // queue the stream buffer for the writer
+    void
+    queueBuffer( void );
+
+    void
+    writer( void );
+
+    std::vector<HHState> m_ring;
+    int     m_head;         //!< The index in m_ring of the oldest state held
+    int     m_size;
+    long    m_total;
+    long    m_streamed;     //!< The states before this position have been streamed (or skipped)
+    HHState m_first;
+
+    std::ofstream           m_file;
+    std::vector<char>       m_buffer;
+    std::thread             m_writer;
+    std::mutex              m_mutex;
+    std::condition_variable m_ready;    //!< Signals the writer that a buffer is queued or the stream is closing
+    std::condition_variable m_space;    //!< Signals push_back() that the queue has room
+    std::deque<std::vector<char>> m_queue;
+    bool                    m_stop;
+};
+
+#endif
+
+
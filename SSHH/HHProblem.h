@@ -22,11 +22,14 @@
 #include "HHTypes.h"
 #endif
 
+#include <cassert>
+#include <iostream>
 #include <string>
 #include <vector>
 
 
 class Logger;
+class URand;
 
 
 class HHProblem
@@ -106,15 +109,94 @@ public:
     setSolution( const HHSolution& sol, int mem_idx ) { m_solution[mem_idx] =  sol; }
     
     virtual double
-    distance( int mem_idx1, int mem_idx2 ) const { return 0.0; }
+    distance( int, int ) const { return 0.0; }
+
+    // evaluate a batch of solutions - result i is the objective of solutions[i]
+    // problems that can evaluate solutions concurrently should override this, the default evaluates
+    // each solution in turn in the last memory slot, whose solution is put back before returning (also if
+    // evalauteObj() throws) - any per slot state the problem keeps for that slot reflects the last solution evaluated
+    virtual std::vector<HHObjective>
+    evaluateBatch( const std::vector<HHSolution>& solutions )
+    {
+        std::vector<HHObjective> results(solutions.size());
+        if (solutions.empty())
+            return results;
+
+        assert(!m_solution.empty()); // see setMemorySize()
+        
+        const int mem_idx = (int) m_solution.size() - 1;
+        SlotGuard guard(m_solution[mem_idx]);
+        for (int i = 0; i < solutions.size(); ++i)
+        {
+            m_solution[mem_idx] = solutions[i];
+            results[i] = evalauteObj(mem_idx);
+        }
+        return results;
+    }
+
+    // the number of solutions evaluateBatch() evaluates at once (e.g. one per thread) - the default evaluates one at a time
+    virtual int
+    numWorkers( void ) const { return 1; }
+
+    // the low level heuristics that read the state left by the last evaluation (e.g. a simulation) as well as
+    // the solution they are applied to - see SSHH::setSpeculation()
+    virtual std::vector<int>
+    getHeuristicsThatReadState( void ) const { return std::vector<int>(); }
+    
+    // true if evalauteObj() gives a solution the same objective values whenever it is evaluated
+    virtual bool
+    repeatableEvaluation( void ) const { return true; }
+    
+    // the solution in mem_idx has the objective values value, found without calling evalauteObj( mem_idx ) (e.g. by 
+    // evaluateBatch()) - a problem that keeps the state of its last evaluation should treat mem_idx as evaluated
+    virtual void
+    evaluated( int, const HHObjective& ) {}
+
+    // write the state the problem keeps besides its memory (e.g. which solution its last evaluation was of)
+    // so a run can be resumed - see SSHH::checkpoint()
+    virtual void
+    writeState( std::ostream& ) const {}
+    
+    // read the state written by writeState() once the problem's memory is restored - returns false, 
+    // leaving the problem as it was, if the stream does not hold a valid state
+    virtual bool
+    readState( std::istream& ) { return true; }
+
+    // problem specific statistics logged at the end of a run, one line per string
+    virtual std::vector<std::string>
+    statisticsLog( void ) const { return std::vector<std::string>(); }
 
 
     virtual Logger*
     getLogger( void ) const  { return nullptr; }
+
+    // the random number generator used by the low level heuristics, if there is exactly one
+    // (lets a hyper-heuristic save and restore the heuristics' random sequence, see SSHH::setSpeculation())
+    virtual URand*
+    getRandom( void ) { return nullptr; }
     
 protected:
 
     std::vector<HHSolution> m_solution;
+    
+private:
+    
+    // holds the solution of a memory slot and puts it back when it goes out of scope
+    class SlotGuard
+    {
+    public:
+        explicit SlotGuard( HHSolution& slot ): m_slot(slot), m_held() { m_held.swap(m_slot); }
+        ~SlotGuard( void ) { m_slot.swap(m_held); }
+        
+    private:
+        SlotGuard( const SlotGuard& )=delete;
+        
+        SlotGuard&
+        operator=( const SlotGuard& )=delete;
+        
+        HHSolution& m_slot;
+        HHSolution  m_held;
+    };
 };
 
 
@@ -0,0 +1,156 @@
+/* HHSolutionOps 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$$$
+ $   HHSolutionOps.h   $
+ $$$$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ Comparison, distance and hash kernels for HHSolution - see HHTypes.h for the compact (one byte) encoding
+
+ The loops are branch free over contiguous DVType arrays and run in fixed length blocks, which the compiler
+ vectorises at -O2 (a loop with a variable trip count is only vectorised at -O3), so with the compact encoding
+ 16 (SSE) or 32 (AVX2) decision variables are compared per instruction.
+
+ The hash of a solution is the sum of a mixed term for each (position, value) pair, so when a few
+ decision variables change the hash is updated in O(1) per change rather than recomputed - see rehash().
+ Two solutions with different hashes are different; equal hashes must be confirmed with equal().
+
+*/
+
+
+#ifndef __HHSOLUTIONOPS_H__
+#define __HHSOLUTIONOPS_H__
+
+#ifndef __HHTYPES_H__
+#include "HHTypes.h"
+#endif
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <cassert>
+#include <type_traits>
+
+
+class HHSolutionOps
+{
+public:
+
+    static bool
+    equal( const HHSolution& s1, const HHSolution& s2 )
+    {
+        return s1.size() == s2.size() && (s1.empty() || std::memcmp(s1.data(), s2.data(), s1.size() * sizeof(DVType)) == 0);
+    }
+
+    // the number of decision variables that differ
+    static int
+    hamming( const HHSolution& s1, const HHSolution& s2 )
+    {
+        assert(s1.size() == s2.size());
+
+        const DVType* a = s1.data();
+        const DVType* b = s2.data();
+        const int n = (int) s1.size();
+
+        int count = 0;
+        int i = 0;
+        for (; i + BLOCK <= n; i += BLOCK)
+        {
+            // at most BLOCK < 256 differences so a byte wide counter vectorises best
+            uint8_t block = 0;
+            for (int j = 0; j < BLOCK; ++j)
+                block += (a[i + j] != b[i + j]);
+            count += block;
+        }
+        for (; i < n; ++i)
+            count += (a[i] != b[i]);
+        return count;
+    }
+
+    // the squared Euclidean distance between the option indexes
+    static long
+    squaredDistance( const HHSolution& s1, const HHSolution& s2 )
+    {
+        assert(s1.size() == s2.size());
+
+        const DVType* a = s1.data();
+        const DVType* b = s2.data();
+        const int n = (int) s1.size();
+
+        long d = 0;
+        int i = 0;
+        for (; i + BLOCK <= n; i += BLOCK)
+        {
+            BlockSum block = 0;
+            for (int j = 0; j < BLOCK; ++j)
+            {
+                const BlockSum tmp = (BlockSum) a[i + j] - (BlockSum) b[i + j];
+                block += tmp * tmp;
+            }
+            d += block;
+        }
+        for (; i < n; ++i)
+        {
+            const long tmp = (long) a[i] - (long) b[i];
+            d += tmp * tmp;
+        }
+        return d;
+    }
+
+    static double
+    distance( const HHSolution& s1, const HHSolution& s2 ) { return std::sqrt( (double) squaredDistance(s1, s2) ); }
+
+    // the contribution of decision variable i with value v to the hash
+    static uint64_t
+    term( int i, DVType v )
+    {
+        // splitmix64 finaliser
+        uint64_t x = ((uint64_t) i << 16) ^ (uint64_t) (uint16_t) v;
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    static uint64_t
+    hash( const HHSolution& s )
+    {
+        uint64_t h = 0;
+        for (int i = 0; i < s.size(); ++i)
+            h += term(i, s[i]);
+        return h;
+    }
+
+    // the hash after decision variable i changes from oldValue to newValue - O(1)
+    static uint64_t
+    rehash( uint64_t h, int i, DVType oldValue, DVType newValue ) { return h + term(i, newValue) - term(i, oldValue); }
+
+    // the hash of solution given h, the hash of base - only the decision variables that differ are mixed
+    static uint64_t
+    rehash( uint64_t h, const HHSolution& base, const HHSolution& solution )
+    {
+        if (base.size() != solution.size())
+            return hash(solution);
+
+        for (int i = 0; i < solution.size(); ++i)
+        {
+            if (base[i] != solution[i])
+                h = rehash(h, i, base[i], solution[i]);
+        }
+        return h;
+    }
+
+private:
+
+    enum { BLOCK = 64 };
+
+    // BLOCK squared differences of one byte values fit in an int
+    typedef std::conditional<sizeof(DVType) == 1, int, long>::type BlockSum;
+};
+
+#endif
+
+
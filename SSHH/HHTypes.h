@@ -10,6 +10,10 @@
 
  Basic types for our hyper-heuristics
  
+ A solution holds one option index per decision variable. Define HH_COMPACT_SOLUTION to hold each
+ index in one byte (at most 256 options per decision variable, checked by HOWSProblem::load()),
+ which halves the memory of each stored solution and doubles the width of the kernels in HHSolutionOps.h
+ 
 */
 
 
@@ -17,9 +21,14 @@
 #define __HHTYPES_H__
 
 #include <vector>
+#include <cstdint>
 
 
+#ifdef HH_COMPACT_SOLUTION
+typedef uint8_t DVType;
+#else
 typedef short  DVType;
+#endif
 typedef double ObjType;
 typedef std::vector<DVType> HHSolution;
 typedef std::vector<ObjType> HHObjective;
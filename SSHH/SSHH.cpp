@@ -47,11 +47,26 @@
 #include "AUtils.h"
 #endif
 
+#ifndef __HHSOLUTIONOPS_H__
+#include "HHSolutionOps.h"
+#endif
+
+#ifndef __URAND_H__
+#include "URand.h"
+#endif
+
+#ifndef __HHBINARY_H__
+#include "HHBinary.h"
+#endif
+
 #include <cmath>
 #include <numeric>
 #include <assert.h>
 #include <fstream>
 #include <iomanip>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
 
 #define PREC(X)  std::setprecision((X)) << std::fixed 
 
@@ -61,6 +76,12 @@ SSHH::SSHH( void ): HH("SSHH"),
                     m_mem_idx(0),
                     m_allowance(0.0), 
                     m_learn_rate(0.1),
+                    m_speculation(0),
+                    m_specHits(0),
+                    m_specEvals(0),
+                    m_stopReason(HHBudget::NONE),
+                    m_publishedIters(0),
+                    m_publishedEvals(0),
                     m_hmm(),
                     m_ran(18),
                     m_selector() 
@@ -85,7 +106,7 @@ SSHH::initialise( HHProblem& problem, const HHObjFunc& f, const std::vector<int>
     m_problem  = &problem;
     m_toScalar = f;
     
-    m_problem->setMemorySize(3 + m_cross_pool);
+    m_problem->setMemorySize(3 + m_cross_pool + 1);  /// + SPEC_SOL()
     m_problem->initialiseSolution(CUR_SOL);     /// current solution
     m_problem->initialiseSolution(NEW_SOL);     /// new solution
     m_problem->initialiseSolution(BEST_SOL);    /// best solution
@@ -103,17 +124,31 @@ SSHH::initialise( HHProblem& problem, const HHObjFunc& f, const std::vector<int>
     m_mem_idx               = CUR_SOL;
     m_evals                 = 0;
     m_best_iter             = 0;
+    m_specHits              = 0;
+    m_specEvals             = 0;
+    m_speculated.clear();
+    
+    const std::vector<int> readsState = m_problem->getHeuristicsThatReadState();
+    m_readsState.assign(m_llhNames.size(), false);
+    for (int i = 0; i < readsState.size(); ++i)
+        m_readsState[readsState[i]] = true;
    
     HHObjective objs = m_problem->evalauteObj(CUR_SOL);
-    m_new_obj = m_cur_obj = m_best_obj = toScalar(objs);
+    m_new_obj = m_cur_obj = toScalar(objs);
     
     // is this a multi-objective problem
     if (objs.size() == 1 || m_multi_obj == 0)
         m_multi_obj = 0;
     else m_multi_obj = 1;
     
+    std::unique_lock<std::mutex> lock(m_snapshotMutex);
+    m_best_obj = m_cur_obj;
     m_archive.clear();
     m_archive.update(m_problem->getSolution(CUR_SOL), objs, 0);
+    m_bestSolution   = m_problem->getSolution(CUR_SOL);
+    m_publishedIters = 0;
+    m_publishedEvals = 0;
+    lock.unlock();
     
     m_history.clear();
     
@@ -143,7 +178,7 @@ SSHH::initialise( HHProblem& problem, const HHSolution& initialSolution, const H
     m_problem  = &problem;
     m_toScalar = f;
     
-    m_problem->setMemorySize(3 + m_cross_pool);
+    m_problem->setMemorySize(3 + m_cross_pool + 1);  /// + SPEC_SOL()
     //m_problem->initialiseSolution(CUR_SOL);     /// current solution
     m_problem->setSolution(initialSolution, CUR_SOL);
     m_problem->initialiseSolution(NEW_SOL);     /// new solution
@@ -162,17 +197,31 @@ SSHH::initialise( HHProblem& problem, const HHSolution& initialSolution, const H
     m_mem_idx               = CUR_SOL;
     m_evals                 = 0;
     m_best_iter             = 0;
+    m_specHits              = 0;
+    m_specEvals             = 0;
+    m_speculated.clear();
+    
+    const std::vector<int> readsState = m_problem->getHeuristicsThatReadState();
+    m_readsState.assign(m_llhNames.size(), false);
+    for (int i = 0; i < readsState.size(); ++i)
+        m_readsState[readsState[i]] = true;
    
     HHObjective objs = m_problem->evalauteObj(CUR_SOL);
-    m_new_obj = m_cur_obj = m_best_obj = toScalar(objs);
+    m_new_obj = m_cur_obj = toScalar(objs);
     
     // is this a multi-objective problem
     if (objs.size() == 1 || m_multi_obj == 0)
         m_multi_obj = 0;
     else m_multi_obj = 1;
     
+    std::unique_lock<std::mutex> lock(m_snapshotMutex);
+    m_best_obj = m_cur_obj;
     m_archive.clear();
     m_archive.update(m_problem->getSolution(CUR_SOL), objs, 0);
+    m_bestSolution   = m_problem->getSolution(CUR_SOL);
+    m_publishedIters = 0;
+    m_publishedEvals = 0;
+    lock.unlock();
     
     m_history.clear();
     
@@ -205,12 +254,29 @@ SSHH::endRunLog( void )
         m_logger.flush();
     }
     
+    if (m_logger.level() >= 2)
+    {
+        Message txt1(2);
+        txt1 << "Stopped after " << m_iters << " iterations and " << m_evals << " evaluations (" << HHBudget::name(m_stopReason) << " limit)";
+        m_logger.logMsg(txt1);
+        m_logger.flush();
+    }
+    
+    if (m_speculation > 0 && m_logger.level() >= 2)
+    {
+        Message txt1(2);
+        txt1 << "Speculation depth " << m_speculation << ": " << m_specHits << " of " << m_evals << " evaluations speculated, " 
+             << m_specEvals << " speculative evaluations";
+        m_logger.logMsg(txt1);
+        m_logger.flush();
+    }
+    
     // print out the learned subsequences
     if (m_logger.level() >= 2)
     {
         std::vector<std::string> subseqs = learnedLog();
         Message header(2);
-        header << subseqs.size() << " subsequences learned (with parameters)";
+        header << subseqs.size() << " distinct subsequences learned from " << learned().updates() << " updates";
         m_logger.logMsg(header);
         for (int i = 0; i < subseqs.size(); ++i)
         {
@@ -220,6 +286,25 @@ SSHH::endRunLog( void )
         }
         m_logger.flush();
     }
+    
+    // print out the problem statistics (e.g. simulator telemetry)
+    if (m_logger.level() >= 2)
+    {
+        std::vector<std::string> stats = m_problem->statisticsLog();
+        if (!stats.empty())
+        {
+            Message header(2);
+            header << m_problem->toString() << " statistics";
+            m_logger.logMsg(header);
+            for (int i = 0; i < stats.size(); ++i)
+            {
+                Message txt1(4);
+                txt1 << stats[i];
+                m_logger.logMsg(txt1);
+            }
+            m_logger.flush();
+        }
+    }
 }
 
 std::string
@@ -255,33 +340,25 @@ SSHH::learnedLog( void ) const
 {
     std::vector<std::string> retVal;
 
-    const std::vector<std::vector<SSHHSel>>& learned = m_selector.learned();
+    const SSHHLearned& learned = m_selector.learned();
+
+    // in the order they were first learned
+    std::vector<int> order(learned.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&learned]( int a, int b ) { return learned[a].first < learned[b].first; });
 
-    for (int i = 0; i < learned.size(); ++i)
+    for (int i = 0; i < order.size(); ++i)
     {
+        const SSHHLearned::Entry& e = learned[order[i]];
+        
         std::ostringstream txt2;
-        int offset = 1;
+        txt2 << i + 1 << '\t' << e.first << '\t' << 'x' << e.count << '\t';
+        for (int j = 0; j < e.sequence.size(); ++j)
+            txt2 << m_llhNames[m_heuristics[e.sequence[j].llh()]] << ' ';
 
-        if (i == 0 && learned[i].size() == 1)
-            offset = 0;
-
-        if (offset < learned[i].size())
-        {
-            txt2 << i + 1 << '\t' << learned[i][offset].iteration() << '\t';
-            for (int j = offset; j < learned[i].size(); ++j)
-                txt2 << m_llhNames[m_heuristics[learned[i][j].llh()]] << ' ';
+        txt2 << '\t';
 
-            txt2 << '\t';
-
-            /*for (int j = offset; j < learned[i].size(); ++j)
-            {
-                txt2 << learned[i][j].param();
-                if (j < learned[i].size() - 1)
-                    txt2 << ' ';
-            }*/
-
-            retVal.push_back( txt2.str() );
-        }
+        retVal.push_back( txt2.str() );
     }
 
     return retVal;
@@ -297,6 +374,26 @@ SSHH::addCrossSol( int mem_idx )
 }
 
 
+void
+SSHH::immigrate( const Archive& archive )
+{
+    if (archive.size() == 0)
+        return;
+    
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    
+    int best = 0;
+    for (int i = 0; i < archive.size(); ++i)
+    {
+        m_archive.update(archive[i], archive(i), m_iters);
+        if (toScalar(archive(i)) < toScalar(archive(best)))
+            best = i;
+    }
+    
+    if (!m_multi_obj)
+        m_problem->setSolution(archive[best], CROSS_SOL + rndInt(m_cross_pool));
+}
+
 int
 SSHH::roulette( const std::vector<double>& obj_vals )
 // select a chromosome using roulette wheel selection
@@ -413,15 +510,26 @@ SSHH::acceptance( void )
 double
 SSHH::solve( int iterations )
 // optimise the problem (with online learning)
+{
+    return solve( HHBudget(iterations) );
+}
+
+double
+SSHH::solve( const HHBudget& limits )
+// optimise the problem (with online learning) until the budget is exhausted
 {
     const double ALLOWANCE = 1.05; // allow a 5% increase in objective function value
     
-    if (m_history.empty())
-        m_history.reserve(iterations);
+    assert(limits.limited());
+    
+    HHBudget budget = limits;
+    budget.start();
+    
+    const int evals = m_evals;
     
     HHObjective objs;
     
-    for (int i = 0; i < iterations; ++i, ++m_iters)
+    for (int i = 0; (m_stopReason = budget.exhausted(i, m_evals - evals, m_iters - m_best_iter)) == HHBudget::NONE; ++i, ++m_iters)
     {
         if (m_iters - m_time_last_improvement > m_time_to_initialise)
         {
@@ -452,11 +560,16 @@ SSHH::solve( int iterations )
             // if the member m_new_obj has been set above (for logging purposes)
             // all we need do is increment the count i.e comment out evaluateObj and toScalar
             ++m_evals;  
-            HHObjective objs = evaluateObj();
+            const bool speculate = m_speculation > 0 && m_problem->numWorkers() > 1 && m_problem->getRandom() && m_problem->repeatableEvaluation();
+            HHObjective objs = (speculate) ? speculativeObj() : evaluateObj();
             m_new_obj = toScalar(objs);
 
             // should only be called after evaluate
+            std::unique_lock<std::mutex> lock(m_snapshotMutex);
             m_archive.update(m_problem->getSolution(NEW_SOL), objs, i);
+            m_publishedIters = m_iters + 1;
+            m_publishedEvals = m_evals;
+            lock.unlock();
             
             // do we accept the new solution?
             accepted = acceptance();
@@ -464,7 +577,11 @@ SSHH::solve( int iterations )
             // if the new objective function values dominate the best objective function values
             if (m_new_obj < m_best_obj)
             {
+                lock.lock();
                 m_best_obj      = m_new_obj;
+                m_bestSolution  = m_problem->getSolution(NEW_SOL);
+                lock.unlock();
+                
                 m_best_iter = m_time_last_improvement = m_iters;
                 m_allowance = ALLOWANCE;
                 m_problem->copySolution(NEW_SOL, BEST_SOL);
@@ -493,6 +610,237 @@ SSHH::solve( int iterations )
 }
 
 
+SSHH::Snapshot
+SSHH::snapshot( void ) const
+{
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    
+    Snapshot snap;
+    snap.iterations   = m_publishedIters;
+    snap.evaluations  = m_publishedEvals;
+    snap.bestObj      = m_best_obj;
+    snap.bestSolution = m_bestSolution;
+    snap.archive      = m_archive;
+    return snap;
+}
+
+HHObjective
+SSHH::speculativeObj( void )
+// evaluate NEW_SOL and the candidates of the next m_speculation acceptance checks in one batch
+{
+    const HHSolution& solution = m_problem->getSolution(NEW_SOL);
+    const uint64_t hash = HHSolutionOps::hash(solution);
+    
+    // a speculated NEW_SOL is treated by the problem as its last evaluation, as it would be without speculation,
+    // so the first check ahead may use a heuristic that reads the state (see HHProblem::getHeuristicsThatReadState())
+    HHObjective objs;
+    const bool speculated = findSpeculation(solution, hash, objs);
+    if (speculated)
+    {
+        ++m_specHits;
+        m_problem->evaluated(NEW_SOL, objs);
+    }
+    
+    // after this check the current solution is either NEW_SOL (accepted) or CUR_SOL (rejected)
+    std::vector<HHSolution> candidates;
+    {
+        HMM hmm1(m_hmm), hmm2(m_hmm);
+        URand ran1(m_ran), ran2(m_ran);
+        URand llhRan1(*m_problem->getRandom()), llhRan2(*m_problem->getRandom());
+        
+        const double param = m_problem->getHeuristicParam();
+        HHSolution accepted = solution;
+        speculate(m_speculation, speculated, accepted, hmm1, ran1, llhRan1, candidates);
+        speculate(m_speculation, speculated, m_problem->getSolution(CUR_SOL), hmm2, ran2, llhRan2, candidates);
+        m_problem->setHeuristicParam(param);
+    }
+    
+    // NEW_SOL, unless it was speculated, is the first of the batch and is evaluated alongside the new candidates
+    std::vector<HHSolution> batch;
+    std::vector<uint64_t> hashes;
+    if (!speculated)
+    {
+        batch.push_back(solution);
+        hashes.push_back(hash);
+    }
+    
+    HHObjective value;
+    for (int i = 0; i < candidates.size(); ++i)
+    {
+        uint64_t h = HHSolutionOps::hash(candidates[i]);
+        
+        bool duplicate = (h == hash && HHSolutionOps::equal(solution, candidates[i])) || findSpeculation(candidates[i], h, value);
+        for (int j = 0; j < batch.size() && !duplicate; ++j)
+            duplicate = (hashes[j] == h && HHSolutionOps::equal(batch[j], candidates[i]));
+        
+        if (!duplicate)
+        {
+            batch.push_back(candidates[i]);
+            hashes.push_back(h);
+        }
+    }
+    
+    if (batch.empty())
+        return objs;
+    
+    std::vector<HHObjective> values = m_problem->evaluateBatch(batch);
+    
+    int first = 0;
+    if (!speculated)
+    {
+        // the problem treats NEW_SOL as its last evaluation, as evalauteObj() would
+        objs = values[first++];
+        m_problem->evaluated(NEW_SOL, objs);
+    }
+    
+    for (int i = first; i < batch.size(); ++i)
+    {
+        m_speculated.push_back(Speculation());
+        m_speculated.back().hash     = hashes[i];
+        m_speculated.back().solution = batch[i];
+        m_speculated.back().value    = values[i];
+        ++m_specEvals;
+    }
+    
+    // keep the speculations of the last few checks
+    const int maxSpeculated = 8 << m_speculation;
+    if (m_speculated.size() > maxSpeculated)
+        m_speculated.erase(m_speculated.begin(), m_speculated.end() - maxSpeculated);
+    
+    return objs;
+}
+
+void
+SSHH::speculate( int depth, bool readState, const HHSolution& current, HMM& hmm, URand& ran, URand& llhRan, std::vector<HHSolution>& candidates )
+{
+    HHSolution candidate;
+    if (!nextCandidate(current, hmm, ran, llhRan, readState, candidate))
+        return;
+    
+    candidates.push_back(candidate);
+    
+    if (depth > 1)
+    {
+        // the candidate is accepted, or rejected and we continue from current
+        HMM hmm2(hmm);
+        URand ran2(ran), llhRan2(llhRan);
+        // deeper checks follow the evaluation of a candidate that has not been made yet
+        speculate(depth - 1, false, candidate, hmm2, ran2, llhRan2, candidates);
+        speculate(depth - 1, false, current, hmm, ran, llhRan, candidates);
+    }
+}
+
+bool
+SSHH::nextCandidate( const HHSolution& current, HMM& hmm, URand& ran, URand& llhRan, bool readState, HHSolution& candidate )
+// mirrors the selection and applyHeuristic() steps of solve() up to the next acceptance check
+{
+    const int MAX_STEPS = 1000;
+    
+    URand& problemRan = *m_problem->getRandom();
+    std::swap(m_ran, ran);
+    std::swap(problemRan, llhRan);
+    
+    bool found = false;
+    m_problem->setSolution(current, SPEC_SOL());
+    for (int t = 0; t < MAX_STEPS; ++t)
+    {
+        SSHHSel sel(-1, hmm.run());
+        
+        m_problem->setHeuristicParam((double) sel.param());
+        int h = m_heuristics[sel.llh()];
+        
+        // the problem does not hold the evaluation this heuristic would read
+        if (m_readsState[h] && !readState)
+            break;
+        
+        if (m_problem->getHeuristicType(h)[0] == 'C') // "CROSSOVER"
+            m_problem->applyHeuristic(h, SPEC_SOL(), getCrossSol(), SPEC_SOL());
+        else m_problem->applyHeuristic(h, SPEC_SOL(), SPEC_SOL());
+        
+        if (sel.acceptCheck() == 1)
+        {
+            found = true;
+            break;
+        }
+    }
+    candidate = m_problem->getSolution(SPEC_SOL());
+    
+    std::swap(m_ran, ran);
+    std::swap(problemRan, llhRan);
+    return found;
+}
+
+bool
+SSHH::findSpeculation( const HHSolution& solution, uint64_t hash, HHObjective& value ) const
+{
+    for (int i = (int) m_speculated.size() - 1; i >= 0; --i)
+    {
+        if (m_speculated[i].hash == hash && HHSolutionOps::equal(m_speculated[i].solution, solution))
+        {
+            value = m_speculated[i].value;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+SSHH::checkSpeculation( int iterations, int depth, const std::string& fileName )
+{
+    const int speculation = m_speculation;
+    
+    if (!checkpoint(fileName))
+        return false;
+    
+    setSpeculation(0);
+    solve(iterations);
+    
+    const Archive archive    = m_archive;
+    const HHSolution best    = m_bestSolution;
+    const double bestObj     = m_best_obj;
+    
+    std::string error;
+    if (!restore(fileName))
+        error = "could not restore the checkpoint";
+    else
+    {
+        setSpeculation(depth);
+        solve(iterations);
+        
+        if (!(m_archive == archive))
+            error = "the archives differ";
+        else if (m_bestSolution != best || m_best_obj != bestObj)
+            error = "the best solutions differ";
+    }
+    
+    setSpeculation(speculation);
+    std::remove(fileName.c_str());
+    
+    if (!error.empty())
+    {
+        if (m_logger.level() >= 1)
+        {
+            Message txt(1);
+            txt << "Speculation check failed after " << iterations << " iterations at depth " << depth << ": " << error;
+            m_logger.logMsg(txt);
+            m_logger.flush();
+        }
+        return false;
+    }
+    
+    if (m_logger.level() >= 2)
+    {
+        Message txt(2);
+        txt << "Speculation check passed after " << iterations << " iterations at depth " << depth << ", " 
+            << m_specHits << " speculated evaluations used";
+        if (m_problem->numWorkers() < 2)
+            txt << " (speculation is off, the problem evaluates one solution at a time)";
+        m_logger.logMsg(txt);
+        m_logger.flush();
+    }
+    return true;
+}
+
 bool
 SSHH::save( const std::string& fileName ) const
 {
@@ -566,5 +914,358 @@ SSHH::saveSolution( const std::string& fileName ) const
     return true;
 }
 
-//
+// the checkpoint file format - increment CHECKPOINT_VERSION when the layout changes
+static const char     CHECKPOINT_MAGIC[8] = { 'S', 'S', 'H', 'H', 'C', 'K', 'P', 'T' };
+static const uint32_t CHECKPOINT_VERSION  = 3;
+
+static const uint64_t STATE_BYTES = 4 + 2 * sizeof(clock_t) + 2 * sizeof(double);   /// bytes per HHState written
+
+static void
+writeState( std::ostream& ostr, const HHState& s )
+{
+    HHBinary::write(ostr, (uint8_t) s.llh());
+    HHBinary::write(ostr, (uint8_t) s.param());
+    HHBinary::write(ostr, s.htype());
+    HHBinary::write(ostr, s.accepted());
+    HHBinary::write(ostr, s.start());
+    HHBinary::write(ostr, s.finish());
+    HHBinary::write(ostr, s.cur_obj());
+    HHBinary::write(ostr, s.new_obj());
+}
+
+static bool
+readState( std::istream& istr, HHState& s )
+{
+    uint8_t llh = 0, param = 0;
+    char htype = 0, accepted = 0;
+    clock_t start = 0, finish = 0;
+    double cur_obj = 0.0, new_obj = 0.0;
+    
+    if (!HHBinary::read(istr, llh) || !HHBinary::read(istr, param) || !HHBinary::read(istr, htype) || !HHBinary::read(istr, accepted) ||
+        !HHBinary::read(istr, start) || !HHBinary::read(istr, finish) || !HHBinary::read(istr, cur_obj) || !HHBinary::read(istr, new_obj))
+        return false;
+    
+    s = HHState(llh, param, htype, accepted, start, finish, cur_obj, new_obj);
+    return true;
+}
+
+bool
+SSHH::checkpoint( const std::string& fileName ) const
+{
+    assert(m_problem);
+    
+    const std::string tmpName = fileName + ".tmp";
+    
+    std::ofstream to( tmpName, std::ios::binary );
+    
+    if (!to)
+    {
+        if (m_logger.level() >= 1)
+        {
+            Message txt(1);
+            txt << "Could not open " << tmpName << " for checkpoint";
+            m_logger.logMsg(txt);
+            m_logger.flush();
+        }
+        return false;
+    }
+    
+    to.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    HHBinary::write(to, CHECKPOINT_VERSION);
+    HHBinary::write(to, (uint8_t) sizeof(DVType));
+    
+    // the configuration a restoring SSHH must share
+    HHBinary::write(to, m_heuristics);
+    HHBinary::write(to, (int32_t) m_cross_pool);
+    
+    // counters
+    HHBinary::write(to, (int32_t) m_multi_obj);
+    HHBinary::write(to, (int32_t) m_time_to_initialise);
+    HHBinary::write(to, (int32_t) m_time_last_improvement);
+    HHBinary::write(to, (int32_t) m_mem_idx);
+    HHBinary::write(to, m_allowance);
+    HHBinary::write(to, m_learn_rate);
+    HHBinary::write(to, (int32_t) m_iters);
+    HHBinary::write(to, (int32_t) m_evals);
+    HHBinary::write(to, (int32_t) m_best_iter);
+    HHBinary::write(to, m_best_obj);
+    HHBinary::write(to, m_cur_obj);
+    HHBinary::write(to, m_new_obj);
+    HHBinary::write(to, m_usage);
+    HHBinary::write(to, (int64_t) m_specHits);
+    HHBinary::write(to, (int64_t) m_specEvals);
+    
+    // random number generators
+    m_ran.write(to);
+    m_hmm.random().write(to);
+    URand* problemRan = m_problem->getRandom();
+    HHBinary::write(to, (uint8_t) (problemRan != nullptr));
+    if (problemRan)
+        problemRan->write(to);
+    
+    // the HMM and the selector
+    HHBinary::write(to, m_hmm.initial_probs());
+    HHBinary::write(to, m_hmm.trans_probs());
+    HHBinary::write(to, (uint64_t) m_hmm.emiss_probs().size());
+    for (int i = 0; i < m_hmm.emiss_probs().size(); ++i)
+        HHBinary::write(to, m_hmm.emiss_probs(i));
+    HHBinary::write(to, m_hmm.output());
+    m_selector.write(to);
+    
+    // the archive, the best solution and the problem's memory
+    m_archive.write(to);
+    HHBinary::write(to, m_bestSolution);
+    HHBinary::write(to, (int32_t) m_publishedIters);
+    HHBinary::write(to, (int32_t) m_publishedEvals);
+    
+    HHBinary::write(to, (int32_t) SPEC_SOL());
+    for (int i = 0; i < SPEC_SOL(); ++i)
+        HHBinary::write(to, m_problem->getSolution(i));
+    
+    // the run log - its first state, its length and the states awaiting an acceptance decision
+    int pending = m_history.size();
+    while (pending > 0 && m_history.index(pending - 1) > 0 && m_history[pending - 1].accepted() == ' ')
+        --pending;
+    
+    HHBinary::write(to, (int64_t) m_history.total());
+    writeState(to, m_history.first());
+    HHBinary::write(to, (uint64_t) (m_history.size() - pending));
+    for (int i = pending; i < m_history.size(); ++i)
+        writeState(to, m_history[i]);
+    
+    // the problem's own state, e.g. the solution its last evaluation was of
+    std::ostringstream problemState;
+    m_problem->writeState(problemState);
+    const std::string str = problemState.str();
+    HHBinary::write(to, std::vector<char>(str.begin(), str.end()));
+    
+    to.close();
+    
+    if (!to || std::rename(tmpName.c_str(), fileName.c_str()) != 0)
+    {
+        if (m_logger.level() >= 1)
+        {
+            Message txt(1);
+            txt << "Could not write checkpoint " << fileName;
+            m_logger.logMsg(txt);
+            m_logger.flush();
+        }
+        std::remove(tmpName.c_str());
+        return false;
+    }
+    
+    if (m_logger.level() >= 2)
+    {
+        Message txt(2);
+        txt << "Checkpoint at iteration " << m_iters << " saved to " << fileName;
+        m_logger.logMsg(txt);
+        m_logger.flush();
+    }
+    
+    return true;
+}
+
+bool
+SSHH::restore( const std::string& fileName )
+{
+    assert(m_problem);
+    
+    std::ifstream from( fileName, std::ios::binary );
+    
+    std::string error;
+    
+    if (!from)
+        error = "could not open file";
+    
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    uint32_t version = 0;
+    uint8_t dvSize = 0;
+    std::vector<int> heuristics;
+    int32_t crossPool = 0;
+    
+    if (error.empty())
+    {
+        if (!from.read(magic, sizeof(magic)) || std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0)
+            error = "not an SSHH checkpoint";
+        else if (!HHBinary::read(from, version) || version != CHECKPOINT_VERSION)
+            error = "unsupported checkpoint version";
+        else if (!HHBinary::read(from, dvSize) || dvSize != sizeof(DVType))
+            error = "different solution encoding (see HH_COMPACT_SOLUTION)";
+        else if (!HHBinary::read(from, heuristics) || heuristics != m_heuristics || !HHBinary::read(from, crossPool) || crossPool != m_cross_pool)
+            error = "different heuristics or crossover pool";
+    }
+    
+    // read everything before changing any state so a bad file leaves this run as it was
+    int32_t multiObj = 0, timeToInitialise = 0, timeLastImprovement = 0, memIdx = 0, iters = 0, evals = 0, bestIter = 0;
+    double allowance = 0.0, learnRate = 0.0, bestObj = 0.0, curObj = 0.0, newObj = 0.0;
+    std::vector<int> usage;
+    int64_t specHits = 0, specEvals = 0;
+    
+    URand ran(m_ran), hmmRan(m_hmm.random()), problemRan;
+    uint8_t hasProblemRan = 0;
+    
+    std::vector<double> pi;
+    Matrix<double> A;
+    std::vector<Matrix<double>> B;
+    std::vector<std::vector<int>> y;
+    SSHHSelector selector(m_selector);
+    
+    Archive archive;
+    HHSolution bestSolution;
+    int32_t publishedIters = 0, publishedEvals = 0, slots = 0;
+    std::vector<HHSolution> solutions;
+    int64_t historyTotal = 0;
+    HHState historyFirst;
+    std::vector<HHState> history;
+    std::vector<char> problemState;
+    uint64_t n = 0;
+    
+    if (error.empty())
+    {
+        if (!HHBinary::read(from, multiObj) || !HHBinary::read(from, timeToInitialise) || !HHBinary::read(from, timeLastImprovement) ||
+            !HHBinary::read(from, memIdx) || !HHBinary::read(from, allowance) || !HHBinary::read(from, learnRate) ||
+            !HHBinary::read(from, iters) || !HHBinary::read(from, evals) || !HHBinary::read(from, bestIter) ||
+            !HHBinary::read(from, bestObj) || !HHBinary::read(from, curObj) || !HHBinary::read(from, newObj) ||
+            !HHBinary::read(from, usage) || !HHBinary::read(from, specHits) || !HHBinary::read(from, specEvals))
+            error = "truncated counters";
+        else if (!ran.read(from) || !hmmRan.read(from) || !HHBinary::read(from, hasProblemRan) || (hasProblemRan && !problemRan.read(from)))
+            error = "truncated random number generators";
+        else if (hasProblemRan != (m_problem->getRandom() != nullptr))
+            error = "different problem";
+    }
+    
+    if (error.empty())
+    {
+        if (!HHBinary::read(from, pi) || !HHBinary::read(from, A) || !HHBinary::read(from, n) || n != m_hmm.emiss_probs().size())
+            error = "bad HMM";
+        
+        B.resize(n);
+        for (int i = 0; i < B.size() && error.empty(); ++i)
+        {
+            if (!HHBinary::read(from, B[i]) || B[i].rows() != m_hmm.emiss_probs(i).rows() || B[i].cols() != m_hmm.emiss_probs(i).cols())
+                error = "bad HMM";
+        }
+        
+        if (error.empty() && (pi.size() != m_hmm.initial_probs().size() || A.rows() != m_hmm.trans_probs().rows() || A.cols() != m_hmm.trans_probs().cols()))
+            error = "different HMM";
+        else if (error.empty() && (!HHBinary::read(from, y) || !selector.read(from)))
+            error = "bad selector";
+    }
+    
+    if (error.empty())
+    {
+        const int length = (int) m_problem->getSolution(CUR_SOL).size();
+        
+        if (!archive.read(from) || !HHBinary::read(from, bestSolution) || !HHBinary::read(from, publishedIters) || !HHBinary::read(from, publishedEvals))
+            error = "bad archive";
+        else if (!HHBinary::read(from, slots) || slots != SPEC_SOL())
+            error = "different problem memory";
+        
+        solutions.resize((error.empty()) ? slots : 0);
+        for (int i = 0; i < solutions.size() && error.empty(); ++i)
+        {
+            if (!HHBinary::read(from, solutions[i]) || solutions[i].size() != length)
+                error = "bad solution in problem memory";
+        }
+    }
+    
+    if (error.empty())
+    {
+        if (!HHBinary::read(from, historyTotal) || !readState(from, historyFirst) || !HHBinary::read(from, n) || historyTotal < 0 || 
+            n > (uint64_t) historyTotal || !HHBinary::fits(from, n, STATE_BYTES))
+            error = "bad run log";
+        
+        history.resize((error.empty()) ? n : 0);
+        for (int i = 0; i < history.size() && error.empty(); ++i)
+        {
+            if (!readState(from, history[i]))
+                error = "bad run log";
+        }
+        
+        if (error.empty() && !HHBinary::read(from, problemState))
+            error = "bad problem state";
+    }
+    
+    // the problem's state refers to its memory so is read once the memory is set - 
+    // if the state is not valid the problem's memory is put back
+    if (error.empty())
+    {
+        std::vector<HHSolution> previous(solutions.size());
+        for (int i = 0; i < solutions.size(); ++i)
+        {
+            previous[i] = m_problem->getSolution(i);
+            m_problem->setSolution(solutions[i], i);
+        }
+        
+        std::istringstream problemStr( std::string(problemState.begin(), problemState.end()) );
+        if (!m_problem->readState(problemStr))
+        {
+            for (int i = 0; i < previous.size(); ++i)
+                m_problem->setSolution(previous[i], i);
+            error = "bad problem state";
+        }
+    }
+    
+    if (!error.empty())
+    {
+        if (m_logger.level() >= 1)
+        {
+            Message txt(1);
+            txt << "Could not restore checkpoint " << fileName << ": " << error;
+            m_logger.logMsg(txt);
+            m_logger.flush();
+        }
+        return false;
+    }
+    
+    m_multi_obj             = multiObj;
+    m_time_to_initialise    = timeToInitialise;
+    m_time_last_improvement = timeLastImprovement;
+    m_mem_idx               = memIdx;
+    m_allowance             = allowance;
+    m_learn_rate            = learnRate;
+    m_iters                 = iters;
+    m_evals                 = evals;
+    m_best_iter             = bestIter;
+    m_cur_obj               = curObj;
+    m_new_obj               = newObj;
+    m_usage                 = usage;
+    m_specHits              = specHits;
+    m_specEvals             = specEvals;
+    m_speculated.clear();
+    
+    m_ran = ran;
+    m_hmm.random() = hmmRan;
+    if (hasProblemRan)
+        *m_problem->getRandom() = problemRan;
+    
+    m_hmm.initial_probs(pi);
+    m_hmm.trans_probs(A);
+    m_hmm.emiss_probs(B);
+    m_hmm.output(y);
+    m_selector = selector;
+    
+    m_history.resume(historyFirst, historyTotal - (long) history.size());
+    for (int i = 0; i < history.size(); ++i)
+        m_history.push_back(history[i]);
+    
+    std::unique_lock<std::mutex> lock(m_snapshotMutex);
+    m_best_obj       = bestObj;
+    m_archive        = archive;
+    m_bestSolution   = bestSolution;
+    m_publishedIters = publishedIters;
+    m_publishedEvals = publishedEvals;
+    lock.unlock();
+    
+    if (m_logger.level() >= 1)
+    {
+        Message txt(1);
+        txt << "Restored checkpoint " << fileName << " at iteration " << m_iters << " with best objective " << m_best_obj;
+        m_logger.logMsg(txt);
+        m_logger.flush();
+    }
+    
+    return true;
+}
 
+//
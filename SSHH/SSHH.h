@@ -56,10 +56,18 @@
 #include "HHState.h"
 #endif
 
+#ifndef __HHBUDGET_H__
+#include "HHBudget.h"
+#endif
+
 #ifndef __LOGGER_H__
 #include "ALogger.h"
 #endif
 
+#include <cstdint>
+#include <algorithm>
+#include <mutex>
+
 class SSHH : public HH
 {
 public:
@@ -86,9 +94,64 @@ public:
     void
     setMultiObj( bool mo ) { m_multi_obj =  mo; }
     
+    // Speculative pipelining - at each acceptance check the candidates of the next depth acceptance checks, for both
+    // the accept and the reject branch of each check, are generated ahead of time from copies of the HMM and random
+    // number generators and evaluated, together with the candidate of the check itself, in one concurrent 
+    // HHProblem::evaluateBatch() call. A later check whose candidate was speculated uses the stored objective values.
+    // Either way the problem is then told the candidate of the check is its last evaluation (HHProblem::evaluated()),
+    // so the state the low level heuristics read (HHProblem::getHeuristicsThatReadState()) is that of the last 
+    // candidate as without speculation. A candidate is only speculated if it does not depend on a state that does not
+    // exist yet, i.e. a heuristic that reads the state is only applied ahead of time for the first check after a 
+    // speculated candidate. The sequence of candidates, acceptances and learning is unchanged; speculation that turns
+    // out wrong (e.g. after the HMM learns) is discarded. Requires HHProblem::numWorkers() > 1, HHProblem::getRandom()
+    // and HHProblem::repeatableEvaluation() (speculation is skipped otherwise, e.g. for a HOWSProblem with one thread
+    // or warm start) - depth 0 (the default) turns speculation off, see also checkSpeculation()
+    void
+    setSpeculation( int depth ) { m_speculation = std::max(0, depth); m_speculated.clear(); }
+    
+    int
+    speculation( void ) const { return m_speculation; }
+    
+    // the number of acceptance checks that used a speculated evaluation
+    long
+    speculationHits( void ) const { return m_specHits; }
+    
+    // the number of speculated evaluations
+    long
+    speculationEvals( void ) const { return m_specEvals; }
+    
+    // Check that speculation does not change a run - from the current state run iterations without speculation, 
+    // go back (via a checkpoint written to fileName and removed afterwards), run them again with speculation depth
+    // and compare the archives and best solutions. Returns false, logging why, if they differ or the checkpoint
+    // fails. The run continues from where the speculative run ended, with the speculation depth it had before
+    bool
+    checkSpeculation( int iterations, int depth, const std::string& fileName );
+    
     double
     solve( int iterations = 1 ) override;
     
+    // optimise until one of the budget's limits is reached - see HHBudget
+    double
+    solve( const HHBudget& budget );
+    
+    // the limit that ended the last solve()
+    HHBudget::Limit
+    stopReason( void ) const { return m_stopReason; }
+    
+    // the state of a run that may be read by another thread while solve() runs
+    struct Snapshot
+    {
+        int         iterations;     //!< as of the last objective function evaluation
+        int         evaluations;
+        double      bestObj;
+        HHSolution  bestSolution;
+        Archive     archive;
+    };
+    
+    // thread safe
+    Snapshot
+    snapshot( void ) const;
+    
     const HMM&
     hmm( void ) const { return m_hmm; }
     
@@ -104,7 +167,7 @@ public:
     void
     learnRate( double lr ) { m_learn_rate = lr; }
 
-    const std::vector<std::vector<SSHHSel>>&
+    const SSHHLearned&
     learned( void ) const { return m_selector.learned(); }
 
     std::vector<std::string>
@@ -117,11 +180,31 @@ public:
     const Archive&
     archive( void ) const { return m_archive; }
     
+    // add the solutions of another archive (e.g. from another island, see SSHHIslands) to this one
+    // in single objective mode the best migrant also replaces a member of the crossover pool
+    void
+    immigrate( const Archive& archive );
+    
     bool
     save( const std::string& fileName ) const;
     
     bool
     saveSolution( const std::string& fileName ) const;
+    
+    // Checkpoint and resume - write the complete state of a run (counters, random number generators, HMM, selector,
+    // archive, every solution in the problem's memory and the problem's own state, see HHProblem::writeState()) to 
+    // fileName in binary. restore() reads it back into an SSHH initialised with the same problem, objective function
+    // and heuristics, and solve() then continues exactly as the checkpointed run would have (the problem's evaluations
+    // must not depend on when they are made, see HHProblem::repeatableEvaluation()). Not restored: speculated 
+    // evaluations (see setSpeculation()), which are made again, and whatever the problem leaves out of its state
+    // (e.g. HOWSProblem's evaluation cache). Only the first entry of the run log and the entries awaiting an 
+    // acceptance decision are kept.
+    // Call between solve()s, e.g. every few thousand iterations - the file is written to fileName.tmp and then renamed
+    bool
+    checkpoint( const std::string& fileName ) const;
+    
+    bool
+    restore( const std::string& fileName );
 
     void
     endRunLog( void ) override;
@@ -151,6 +234,27 @@ private:
     HHObjective 
     evaluateObj( void ) {  return m_problem->evalauteObj(m_mem_idx);  } 
     
+    // evaluateObj() with speculative pipelining - see setSpeculation()
+    HHObjective
+    speculativeObj( void );
+    
+    // append the candidates of the next depth acceptance checks starting from current - readState is true if the
+    // problem holds the state the first of these checks would see, see nextCandidate()
+    void
+    speculate( int depth, bool readState, const HHSolution& current, HMM& hmm, URand& ran, URand& llhRan, std::vector<HHSolution>& candidates );
+    
+    // the candidate at the next acceptance check starting from current, using hmm, ran and llhRan instead of 
+    // m_hmm, m_ran and the problem's random number generator - the solution is built in the memory slot SPEC_SOL()
+    // returns false if there is no candidate, e.g. a heuristic reads the problem's state and readState is false
+    bool
+    nextCandidate( const HHSolution& current, HMM& hmm, URand& ran, URand& llhRan, bool readState, HHSolution& candidate );
+    
+    bool
+    findSpeculation( const HHSolution& solution, uint64_t hash, HHObjective& value ) const;
+    
+    int
+    SPEC_SOL( void ) const { return CROSS_SOL + m_cross_pool; }
+    
     double
     run( int iterations );
     
@@ -167,6 +271,26 @@ private:
     double m_allowance;             //!< Allow solutions close to m_best_obj to be accepted
     double m_learn_rate;            //!< Learning rate 
     
+    struct Speculation
+    {
+        uint64_t    hash;
+        HHSolution  solution;
+        HHObjective value;
+    };
+    
+    int  m_speculation;             //!< The number of acceptance checks to look ahead (0 is off)
+    long m_specHits;
+    long m_specEvals;
+    std::vector<Speculation> m_speculated;  //!< Recently speculated evaluations, oldest first
+    std::vector<bool> m_readsState;         //!< Indexed by heuristic, see HHProblem::getHeuristicsThatReadState()
+    
+    HHBudget::Limit m_stopReason;
+    
+    mutable std::mutex m_snapshotMutex;     //!< Guards m_archive, m_best_obj and the published values below
+    HHSolution m_bestSolution;              //!< A copy of the problem's BEST_SOL
+    int m_publishedIters;
+    int m_publishedEvals;
+    
     HMM m_hmm;
     URand m_ran;
     SSHHSelector m_selector;
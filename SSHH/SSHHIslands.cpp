@@ -0,0 +1,294 @@
+/* SSHHIslands 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$$$
+ $   SSHHIslands.cpp   $
+ $$$$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+*/
+
+
+#ifndef __SSHHISLANDS_H__
+#include "SSHHIslands.h"
+#endif
+
+#include <thread>
+#include <string>
+#include <assert.h>
+
+
+SSHHIslands::SSHHIslands( void ): m_migrationInterval(1000),
+                                  m_migrations(0),
+                                  m_shareHMM(true),
+                                  m_islands(),
+                                  m_problems(),
+                                  m_archive()
+{
+    m_logger.getLogLevel( "SSHHIslands" );
+}
+
+void
+SSHHIslands::clear( void )
+{
+    for (int i = 0; i < m_islands.size(); ++i)
+        delete m_islands[i];
+
+    for (int i = 0; i < m_problems.size(); ++i)
+        delete m_problems[i];
+
+    m_islands.clear();
+    m_problems.clear();
+    m_archive.clear();
+    m_migrations = 0;
+}
+
+void
+SSHHIslands::makeIslands( const ProblemFactory& factory, int numIslands, unsigned int seed )
+{
+    assert(numIslands > 0);
+
+    clear();
+
+    // made sequentially - loading a problem logs messages and the Logger is not thread safe
+    for (int i = 0; i < numIslands; ++i)
+    {
+        HHProblem* problem = factory(i);
+        if (!problem)
+        {
+            if (m_logger.level() >= 1)
+            {
+                Message txt(1);
+                txt << "Could not make the problem for island " << i;
+                m_logger.logMsg(txt);
+                m_logger.flush();
+            }
+            exit(EXIT_FAILURE);
+        }
+
+        problem->seed(seed + i);
+        m_problems.push_back(problem);
+
+        m_islands.push_back(new SSHH);
+        m_islands.back()->seed(seed + i);
+    }
+}
+
+void
+SSHHIslands::initialise( const ProblemFactory& factory, int numIslands, unsigned int seed, const HHObjFunc& f, const std::vector<int>& omitLLH )
+{
+    makeIslands(factory, numIslands, seed);
+
+    for (int i = 0; i < size(); ++i)
+    {
+        m_islands[i]->initialise(*m_problems[i], f, omitLLH);
+
+        for (int j = 0; j < m_islands[i]->archive().size(); ++j)
+            m_archive.update(m_islands[i]->archive()[j], m_islands[i]->archive()(j), 0);
+    }
+}
+
+void
+SSHHIslands::initialise( const ProblemFactory& factory, int numIslands, unsigned int seed, const HHSolution& initialSolution, const HHObjFunc& f, const std::vector<int>& omitLLH )
+{
+    makeIslands(factory, numIslands, seed);
+
+    for (int i = 0; i < size(); ++i)
+    {
+        m_islands[i]->initialise(*m_problems[i], initialSolution, f, omitLLH);
+
+        for (int j = 0; j < m_islands[i]->archive().size(); ++j)
+            m_archive.update(m_islands[i]->archive()[j], m_islands[i]->archive()(j), 0);
+    }
+}
+
+int
+SSHHIslands::bestIsland( void ) const
+{
+    int best = 0;
+    for (int i = 1; i < m_islands.size(); ++i)
+    {
+        if (m_islands[i]->bestObj() < m_islands[best]->bestObj())
+            best = i;
+    }
+    return best;
+}
+
+void
+SSHHIslands::run( int iterations )
+{
+    if (size() == 1)
+    {
+        m_islands[0]->solve(iterations);
+        return;
+    }
+
+    // per iteration logging is off while the islands run concurrently - the Logger is not thread safe
+    std::vector<int> levels(size());
+    for (int i = 0; i < size(); ++i)
+    {
+        Logger* logger = m_islands[i]->getLogger();
+        levels[i] = logger->level();
+        logger->level( std::min(levels[i], 2) );
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(size());
+
+    for (int i = 0; i < size(); ++i)
+        workers.emplace_back( [this, i, iterations]( void ) { m_islands[i]->solve(iterations); } );
+
+    for (int i = 0; i < size(); ++i)
+        workers[i].join();
+
+    for (int i = 0; i < size(); ++i)
+        m_islands[i]->getLogger()->level( levels[i] );
+}
+
+void
+SSHHIslands::migrate( void )
+{
+    // merge the island archives
+    for (int i = 0; i < size(); ++i)
+    {
+        const Archive& archive = m_islands[i]->archive();
+        for (int j = 0; j < archive.size(); ++j)
+            m_archive.update(archive[j], archive(j), m_migrations);
+    }
+
+    for (int i = 0; i < size(); ++i)
+        m_islands[i]->immigrate(m_archive);
+
+    // the best island's learned probabilities (its random number generator is not shared)
+    if (m_shareHMM && size() > 1)
+    {
+        const int best = bestIsland();
+        const HMM& hmm = m_islands[best]->hmm();
+
+        for (int i = 0; i < size(); ++i)
+        {
+            if (i == best)
+                continue;
+
+            m_islands[i]->hmm().initial_probs(hmm.initial_probs());
+            m_islands[i]->hmm().trans_probs(hmm.trans_probs());
+            m_islands[i]->hmm().emiss_probs(hmm.emiss_probs());
+        }
+    }
+
+    assert(m_archive.nondominated());
+
+    ++m_migrations;
+
+    if (m_logger.level() >= 2)
+    {
+        Message txt(2);
+        txt << "Migration " << m_migrations << ": " << m_archive.size() << " nondominated solutions, best island " << bestIsland() << " objective " << bestObj();
+        m_logger.logMsg(txt);
+        m_logger.flush();
+    }
+}
+
+double
+SSHHIslands::solve( int iterations )
+{
+    assert(!m_islands.empty());
+
+    for (int done = 0; done < iterations; done += m_migrationInterval)
+    {
+        run( std::min(m_migrationInterval, iterations - done) );
+        migrate();
+    }
+
+    return m_islands[bestIsland()]->finalLogReturn();
+}
+
+bool
+SSHHIslands::selfCheck( const ProblemFactory& factory, unsigned int seed, int iterations )
+{
+    SSHHIslands islands;
+    islands.initialise( factory, 2, seed );
+    islands.setMigrationInterval( std::max(1, iterations / 2) );
+    islands.solve( iterations );
+
+    const Archive& merged = islands.archive();
+
+    std::string error;
+    if (merged.size() == 0)
+        error = "the merged archive is empty";
+    else if (!merged.nondominated())
+        error = "the merged archive holds a dominated solution";
+
+    for (int i = 0; i < islands.size() && error.empty(); ++i)
+    {
+        const Archive& archive = islands.island(i).archive();
+        for (int j = 0; j < archive.size() && error.empty(); ++j)
+        {
+            for (int k = 0; k < merged.size() && error.empty(); ++k)
+            {
+                if (merged.dominates( archive(j), merged(k) ))
+                    error = "a solution of island " + std::to_string(i) + " dominates the merged archive";
+            }
+        }
+    }
+
+    if (!error.empty())
+    {
+        if (islands.m_logger.level() >= 1)
+        {
+            Message txt(1);
+            txt << "Island check failed after " << iterations << " iterations: " << error;
+            islands.m_logger.logMsg(txt);
+            islands.m_logger.flush();
+        }
+        return false;
+    }
+
+    if (islands.m_logger.level() >= 2)
+    {
+        Message txt(2);
+        txt << "Island check passed after " << iterations << " iterations, " << merged.size() << " nondominated solutions";
+        islands.m_logger.logMsg(txt);
+        islands.m_logger.flush();
+    }
+    return true;
+}
+
+void
+SSHHIslands::beginRunLog( int iterations )
+{
+    if (m_logger.level() >= 1)
+    {
+        Message txt(1);
+        txt << "Optimising problem on " << size() << " islands for " << iterations << " iterations, migrating every "
+            << m_migrationInterval << " iterations" << ((m_shareHMM) ? " and sharing the best HMM" : "");
+        m_logger.logMsg(txt);
+        m_logger.flush();
+    }
+
+    for (int i = 0; i < size(); ++i)
+    {
+        m_islands[i]->logProblem(iterations);
+        m_islands[i]->beginRunLog();
+    }
+}
+
+void
+SSHHIslands::endRunLog( void )
+{
+    for (int i = 0; i < size(); ++i)
+        m_islands[i]->endRunLog();
+
+    if (m_logger.level() >= 1)
+    {
+        Message txt(1);
+        txt << m_archive.size() << " nondominated solutions from " << size() << " islands after " << m_migrations
+            << " migrations, best objective " << bestObj() << " on island " << bestIsland();
+        m_logger.logMsg(txt);
+        m_logger.flush();
+    }
+}
+
+//
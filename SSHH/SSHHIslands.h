@@ -0,0 +1,174 @@
+/* SSHHIslands 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$
+ $   SSHHIslands.h   $
+ $$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ An island model of SSHH - K independent SSHH runs on K threads with periodic migration
+
+ Each island has its own HHProblem (made by the ProblemFactory, e.g. a HOWSProblem with its own EPANET project),
+ its own seed and its own HMM. The islands run for migrationInterval() iterations at a time, then their archives
+ are merged into one nondominated archive which is given back to every island (see SSHH::immigrate()). If shareHMM()
+ is set the islands also adopt the initial, transition and emission probabilities of the island with the best
+ objective value. After solve() archive() holds the merged nondominated archive of all the islands.
+
+ The islands run concurrently, so the problems made by the factory must not share mutable state. Per iteration
+ logging (log level 3) of SSHH is turned off while more than one island runs; the run log itself is still kept.
+
+ Example
+
+ SSHHIslands islands;
+ islands.initialise( [&]( int i ) { return new HOWSProblem(instance, seed + i); }, 8, seed, f );
+ islands.setMigrationInterval( 500 );
+ islands.solve( 10000 );
+
+*/
+
+
+#ifndef __SSHHISLANDS_H__
+#define __SSHHISLANDS_H__
+
+#ifndef __SSHH_H__
+#include "SSHH.h"
+#endif
+
+#ifndef __ARCHIVE_H__
+#include "Archive.h"
+#endif
+
+#ifndef __LOGGER_H__
+#include "ALogger.h"
+#endif
+
+#include <functional>
+#include <algorithm>
+#include <vector>
+
+
+class SSHHIslands
+{
+public:
+
+    // make the problem of island i - the SSHHIslands object takes ownership
+    typedef std::function<HHProblem*(int)> ProblemFactory;
+
+    SSHHIslands( void );
+    ~SSHHIslands( void ) { clear(); }
+
+    void
+    clear( void );
+
+    // make numIslands problems and initialise an SSHH on each, island i is seeded with seed + i
+    void
+    initialise( const ProblemFactory& factory,
+                int numIslands,
+                unsigned int seed,
+                const HHObjFunc& f = HHFunc::volume,
+                const std::vector<int>& omitLLH = std::vector<int>() );
+
+    // as above with every island starting from initialSolution
+    void
+    initialise( const ProblemFactory& factory,
+                int numIslands,
+                unsigned int seed,
+                const HHSolution& initialSolution,
+                const HHObjFunc& f = HHFunc::volume,
+                const std::vector<int>& omitLLH = std::vector<int>() );
+
+    // the number of iterations each island runs between migrations (default 1000)
+    void
+    setMigrationInterval( int iterations ) { m_migrationInterval = std::max(1, iterations); }
+
+    int
+    migrationInterval( void ) const { return m_migrationInterval; }
+
+    // should the islands adopt the HMM of the best island at each migration (default true)
+    void
+    setShareHMM( bool share ) { m_shareHMM = share; }
+
+    bool
+    shareHMM( void ) const { return m_shareHMM; }
+
+    // run every island for iterations, migrating every migrationInterval() iterations
+    // returns the final logarithmic return of the best island (see HH::finalLogReturn())
+    double
+    solve( int iterations );
+
+    void
+    beginRunLog( int iterations );
+
+    void
+    endRunLog( void );
+
+    int
+    size( void ) const { return (int) m_islands.size(); }
+
+    SSHH&
+    island( int i ) { return *m_islands[i]; }
+
+    const SSHH&
+    island( int i ) const { return *m_islands[i]; }
+
+    HHProblem&
+    problem( int i ) { return *m_problems[i]; }
+
+    // the island with the lowest best objective value
+    int
+    bestIsland( void ) const;
+
+    double
+    bestObj( void ) const { return (m_islands.empty()) ? 0.0 : m_islands[bestIsland()]->bestObj(); }
+
+    // the best solution of the best island
+    const HHSolution&
+    bestSolution( void ) { return m_problems[bestIsland()]->getSolution(SSHH::BEST_SOL); }
+
+    // the merged nondominated archive of all the islands (as of the last migration)
+    const Archive&
+    archive( void ) const { return m_archive; }
+
+    // the number of migrations so far
+    int
+    migrations( void ) const { return m_migrations; }
+    
+    // a small check of the island model - run 2 islands of factory's problems for iterations, migrating half way,
+    // and check that the merged archive is nondominated and that no solution of an island dominates it
+    // returns false, logging why, if not
+    static bool
+    selfCheck( const ProblemFactory& factory, unsigned int seed, int iterations = 200 );
+
+private:
+
+    SSHHIslands( const SSHHIslands& )=delete;
+
+    SSHHIslands&
+    operator=( const SSHHIslands& )=delete;
+
+    void
+    makeIslands( const ProblemFactory& factory, int numIslands, unsigned int seed );
+
+    // run every island for iterations on its own thread
+    void
+    run( int iterations );
+
+    void
+    migrate( void );
+
+    int  m_migrationInterval;
+    int  m_migrations;
+    bool m_shareHMM;
+
+    std::vector<SSHH*>      m_islands;
+    std::vector<HHProblem*> m_problems;   /// the problem of each island (owned)
+    Archive                 m_archive;
+
+    mutable Logger m_logger;
+};
+
+#endif
+
+
@@ -0,0 +1,160 @@
+/* SSHHLearned 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$
+ $   SSHHLearned.h   $
+ $$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ The subsequences of low level heuristics that SSHHSelector has learned from - a bounded table with counts
+
+ Each distinct subsequence (compared by heuristic and parameter) is held once with the number of times it was
+ learned and the iterations it was first and last learned. Only the last maxLength() selections of a subsequence
+ are kept, and when the table is full the least learned subsequence (the least recent of equals) is replaced, so
+ memory use is bounded by capacity() * maxLength() selections however long the run.
+
+*/
+
+
+#ifndef __SSHHLEARNED_H__
+#define __SSHHLEARNED_H__
+
+#ifndef __SSHHSEL_H__
+#include "SSHHSel.h"
+#endif
+
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+
+
+class SSHHLearned
+{
+public:
+
+    struct Entry
+    {
+        std::vector<SSHHSel> sequence;
+        int      count;     //!< The number of times this subsequence was learned
+        int      first;     //!< The iteration it was first learned
+        int      last;      //!< The iteration it was last learned
+        uint64_t hash;
+    };
+
+    explicit SSHHLearned( int capacity = DEFAULT_CAPACITY, int maxLength = DEFAULT_LENGTH ): m_capacity(capacity),
+                                                                                             m_maxLength(maxLength),
+                                                                                             m_updates(0),
+                                                                                             m_entries() {}
+    ~SSHHLearned( void )=default;
+
+    void
+    clear( void ) { m_entries.clear(); m_updates = 0; }
+
+    // add the subsequence learned from a selector history - the first selection of the history is carried over
+    // from the previous update so is left out (unless it is the only one)
+    void
+    add( const std::vector<SSHHSel>& history )
+    {
+        if (history.empty())
+            return;
+
+        ++m_updates;
+
+        const int begin = std::max( (history.size() == 1) ? 0 : 1, (int) history.size() - m_maxLength );
+        const int iter  = history[begin].iteration();
+
+        uint64_t h = 0xCBF29CE484222325ULL;
+        for (int i = begin; i < history.size(); ++i)
+            h = (h ^ key(history[i])) * 0x100000001B3ULL;
+
+        for (int i = 0; i < m_entries.size(); ++i)
+        {
+            if (m_entries[i].hash == h && same(m_entries[i].sequence, history, begin))
+            {
+                ++m_entries[i].count;
+                m_entries[i].last = iter;
+                return;
+            }
+        }
+
+        Entry e;
+        e.sequence.assign( history.begin() + begin, history.end() );
+        e.count = 1;
+        e.first = e.last = iter;
+        e.hash  = h;
+
+        if (m_entries.size() < m_capacity)
+        {
+            m_entries.push_back(e);
+            return;
+        }
+
+        // replace the least learned, least recent subsequence
+        int worst = 0;
+        for (int i = 1; i < m_entries.size(); ++i)
+        {
+            if (m_entries[i].count < m_entries[worst].count ||
+                (m_entries[i].count == m_entries[worst].count && m_entries[i].last < m_entries[worst].last))
+                worst = i;
+        }
+        m_entries[worst] = e;
+    }
+
+    // the number of distinct subsequences held
+    int
+    size( void ) const { return (int) m_entries.size(); }
+
+    const Entry&
+    operator[]( int i ) const { return m_entries[i]; }
+
+    const std::vector<Entry>&
+    entries( void ) const { return m_entries; }
+
+    // the number of subsequences added
+    long
+    updates( void ) const { return m_updates; }
+
+    // replace the table, e.g. from a checkpoint (see SSHHSelector::read)
+    void
+    assign( const std::vector<Entry>& entries, long updates ) { m_entries = entries; m_updates = updates; }
+
+    int
+    capacity( void ) const { return m_capacity; }
+
+    int
+    maxLength( void ) const { return m_maxLength; }
+
+private:
+
+    static constexpr int DEFAULT_CAPACITY = 256;
+    static constexpr int DEFAULT_LENGTH   = 64;
+
+    static uint64_t
+    key( const SSHHSel& s ) { return ((uint64_t) s.llh() << 16) | (uint64_t) s.param(); }
+
+    static bool
+    same( const std::vector<SSHHSel>& seq, const std::vector<SSHHSel>& history, int begin )
+    {
+        if (seq.size() != history.size() - begin)
+            return false;
+
+        for (int i = 0; i < seq.size(); ++i)
+        {
+            if (key(seq[i]) != key(history[begin + i]))
+                return false;
+        }
+        return true;
+    }
+
+    int  m_capacity;
+    int  m_maxLength;
+    long m_updates;
+
+    std::vector<Entry> m_entries;
+};
+
+#endif
+
+
@@ -21,6 +21,11 @@ inline bool nearZero( double p )  { return ((p > -__NEAR_ZERO_VALUE__) && (p < _
 
 
 
+#ifndef __HHBINARY_H__
+#include "HHBinary.h"
+#endif
+
+#include <climits>
 #include <assert.h>
 
 
@@ -34,7 +39,6 @@ SSHHSelector::set( HMM* hmm )
     m_learned.clear();
     m_history.clear();
     
-    m_learned.reserve(100);
     m_history.reserve(100);
 
     // how many hidden states have nonz-zero probs i.e. they are 'active' 
@@ -58,6 +62,109 @@ SSHHSelector::set( HMM* hmm )
     }
 }
 
+// an SSHHSel is written field by field as it is not a plain value
+static void
+writeSels( std::ostream& ostr, const std::vector<SSHHSel>& sels )
+{
+    HHBinary::write(ostr, (uint64_t) sels.size());
+    for (int i = 0; i < sels.size(); ++i)
+    {
+        HHBinary::write(ostr, (int32_t) sels[i].iteration());
+        HHBinary::write(ostr, (uint16_t) sels[i].state());
+        HHBinary::write(ostr, (uint16_t) sels[i].llh());
+        HHBinary::write(ostr, (uint16_t) sels[i].param());
+        HHBinary::write(ostr, (uint16_t) sels[i].acceptCheck());
+    }
+}
+
+static bool
+readSels( std::istream& istr, std::vector<SSHHSel>& sels )
+{
+    uint64_t n = 0;
+    if (!HHBinary::read(istr, n) || n > INT_MAX || !HHBinary::fits(istr, n, sizeof(int32_t) + 4 * sizeof(uint16_t)))
+        return false;
+    
+    sels.resize(n);
+    for (int i = 0; i < sels.size(); ++i)
+    {
+        int32_t  iter = 0;
+        uint16_t s[4] = { 0, 0, 0, 0 };
+        if (!HHBinary::read(istr, iter) || !HHBinary::read(istr, s))
+            return false;
+        
+        sels[i] = SSHHSel(iter, { s[0], s[1], s[2], s[3] });
+    }
+    return true;
+}
+
+void
+SSHHSelector::write( std::ostream& ostr ) const
+{
+    HHBinary::write(ostr, (int32_t) m_selCount);
+    HHBinary::write(ostr, (int32_t) m_learnCount);
+    HHBinary::write(ostr, m_activeStates);
+    HHBinary::write(ostr, (uint64_t) m_activeEmissions.size());
+    for (int i = 0; i < m_activeEmissions.size(); ++i)
+        HHBinary::write(ostr, m_activeEmissions[i]);
+    
+    writeSels(ostr, m_history);
+    HHBinary::write(ostr, (int64_t) m_learned.updates());
+    HHBinary::write(ostr, (uint64_t) m_learned.size());
+    for (int i = 0; i < m_learned.size(); ++i)
+    {
+        writeSels(ostr, m_learned[i].sequence);
+        HHBinary::write(ostr, (int32_t) m_learned[i].count);
+        HHBinary::write(ostr, (int32_t) m_learned[i].first);
+        HHBinary::write(ostr, (int32_t) m_learned[i].last);
+        HHBinary::write(ostr, m_learned[i].hash);
+    }
+}
+
+bool
+SSHHSelector::read( std::istream& istr )
+{
+    int32_t selCount = 0, learnCount = 0;
+    if (!HHBinary::read(istr, selCount) || !HHBinary::read(istr, learnCount))
+        return false;
+    
+    m_selCount   = selCount;
+    m_learnCount = learnCount;
+    
+    if (!HHBinary::read(istr, m_activeStates))
+        return false;
+    
+    uint64_t n = 0;
+    if (!HHBinary::read(istr, n) || n > INT_MAX || !HHBinary::fits(istr, n, sizeof(uint64_t)))
+        return false;
+    m_activeEmissions.resize(n);
+    for (int i = 0; i < m_activeEmissions.size(); ++i)
+        if (!HHBinary::read(istr, m_activeEmissions[i]))
+            return false;
+    
+    if (!readSels(istr, m_history))
+        return false;
+    
+    int64_t updates = 0;
+    if (!HHBinary::read(istr, updates) || !HHBinary::read(istr, n) || n > m_learned.capacity())
+        return false;
+    
+    std::vector<SSHHLearned::Entry> learned(n);
+    for (int i = 0; i < learned.size(); ++i)
+    {
+        int32_t count = 0, first = 0, last = 0;
+        if (!readSels(istr, learned[i].sequence) || !HHBinary::read(istr, count) || !HHBinary::read(istr, first) ||
+            !HHBinary::read(istr, last) || !HHBinary::read(istr, learned[i].hash))
+            return false;
+        
+        learned[i].count = count;
+        learned[i].first = first;
+        learned[i].last  = last;
+    }
+    m_learned.assign(learned, updates);
+    
+    return true;
+}
+
 void 
 SSHHSelector::learn( const std::vector<double>& inc )
 // online learning
@@ -76,8 +183,8 @@ SSHHSelector::learn( const std::vector<double>& inc )
         updateProbs( m_hmm->emiss_probs(2)[curr_state], m_activeEmissions[2][curr_state], m_history[i].acceptCheck(), inc[ACCEPT] );
     }
     
-    // save the subsequence we have just learnt from
-    m_learned.push_back( m_history );
+    // count the subsequence we have just learnt from
+    m_learned.add( m_history );
     
     // reset history; set last good heuristic to be the first
     m_history[0] = m_history.back();
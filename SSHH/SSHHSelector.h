@@ -24,6 +24,12 @@
 #include "SSHHSel.h"
 #endif
 
+#ifndef __SSHHLEARNED_H__
+#include "SSHHLearned.h"
+#endif
+
+#include <iostream>
+
 
     
 class SSHHSelector
@@ -67,8 +73,16 @@ public:
     HMM*
     hmm( void ) { return m_hmm; }
     
-    const std::vector<std::vector<SSHHSel>>&
+    const SSHHLearned&
     learned( void ) const { return m_learned; }
+    
+    // write/read the selection state (counts, active probabilities, history and learned subsequences) in binary
+    // the HMM is not written - see SSHH::checkpoint
+    void
+    write( std::ostream& ostr ) const;
+    
+    bool
+    read( std::istream& istr );
 
 //private:
     
@@ -87,7 +101,7 @@ public:
     std::vector<std::vector<int>> m_activeEmissions;
     
     std::vector<SSHHSel> m_history; 
-    std::vector<std::vector<SSHHSel>> m_learned;
+    SSHHLearned          m_learned;
 
 };
 
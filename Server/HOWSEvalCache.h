@@ -0,0 +1,197 @@
+/* HOWSEvalCache 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$$$
+ $   HOWSEvalCache.h   $
+ $$$$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ A bounded least recently used cache of solution evaluations - see HOWSProblem::evalauteObj()
+
+ SSHH revisits solutions (after rejections, swaps of equal options, crossover children identical to a parent)
+ and each hit saves a hydraulic simulation. Entries are found by a 64 bit hash of the solution (HHSolutionOps::hash(),
+ which the caller may maintain incrementally) and the full solution is compared before an entry is returned,
+ so a hash collision is a miss, never a wrong value.
+ When the cache is full the least recently used entry is replaced.
+
+*/
+
+
+#ifndef __HOWSEVALCACHE_H__
+#define __HOWSEVALCACHE_H__
+
+#ifndef __HHTYPES_H__
+#include "HHTypes.h"
+#endif
+
+#ifndef __HHSOLUTIONOPS_H__
+#include "HHSolutionOps.h"
+#endif
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+
+class HOWSEvalCache
+{
+public:
+
+    explicit HOWSEvalCache( int capacity = 4096 ) : m_capacity(capacity), m_head(-1), m_tail(-1), m_hits(0), m_misses(0) {}
+    ~HOWSEvalCache( void )=default;
+
+    // the maximum number of entries - 0 disables the cache
+    void
+    setCapacity( int capacity ) { m_capacity = std::max(0, capacity); clear(); }
+
+    int
+    capacity( void ) const { return m_capacity; }
+
+    int
+    size( void ) const { return (int) m_entries.size(); }
+
+    // remove all entries and reset the statistics
+    void
+    clear( void )
+    {
+        m_index.clear();
+        m_entries.clear();
+        m_head = m_tail = -1;
+        m_hits = m_misses = 0;
+    }
+
+    // returns true and sets value if solution is in the cache
+    bool
+    find( const HHSolution& solution, HHObjective& value ) { return find(solution, hash(solution), value); }
+
+    // as above where h is hash(solution)
+    bool
+    find( const HHSolution& solution, uint64_t h, HHObjective& value )
+    {
+        if (m_capacity > 0)
+        {
+            auto i = m_index.find(h);
+            if (i != m_index.end() && HHSolutionOps::equal(m_entries[i->second].solution, solution))
+            {
+                touch(i->second);
+                value = m_entries[i->second].value;
+                ++m_hits;
+                return true;
+            }
+        }
+        ++m_misses;
+        return false;
+    }
+
+    void
+    insert( const HHSolution& solution, const HHObjective& value ) { insert(solution, hash(solution), value); }
+
+    // as above where h is hash(solution)
+    void
+    insert( const HHSolution& solution, uint64_t h, const HHObjective& value )
+    {
+        if (m_capacity <= 0)
+            return;
+
+        auto i = m_index.find(h);
+
+        int e;
+        if (i != m_index.end())
+        {
+            // the same solution re-evaluated, or a hash collision - replace the entry
+            e = i->second;
+        }
+        else if (m_entries.size() < m_capacity)
+        {
+            e = (int) m_entries.size();
+            m_entries.push_back(Entry());
+            link(e);
+            m_index[h] = e;
+        }
+        else
+        {
+            // replace the least recently used entry
+            e = m_tail;
+            m_index.erase(m_entries[e].hash);
+            m_index[h] = e;
+        }
+
+        m_entries[e].hash     = h;
+        m_entries[e].solution = solution;
+        m_entries[e].value    = value;
+        touch(e);
+    }
+
+    long
+    hits( void ) const { return m_hits; }
+
+    long
+    misses( void ) const { return m_misses; }
+
+    static uint64_t
+    hash( const HHSolution& solution ) { return HHSolutionOps::hash(solution); }
+
+private:
+
+    struct Entry
+    {
+        Entry( void ) : hash(0), prev(-1), next(-1), solution(), value() {}
+
+        uint64_t    hash;
+        int         prev;   /// more recently used
+        int         next;   /// less recently used
+        HHSolution  solution;
+        HHObjective value;
+    };
+
+    // make entry e the most recently used
+    void
+    touch( int e )
+    {
+        if (e == m_head)
+            return;
+        unlink(e);
+        link(e);
+    }
+
+    void
+    link( int e )
+    {
+        m_entries[e].prev = -1;
+        m_entries[e].next = m_head;
+        if (m_head >= 0)
+            m_entries[m_head].prev = e;
+        m_head = e;
+        if (m_tail < 0)
+            m_tail = e;
+    }
+
+    void
+    unlink( int e )
+    {
+        Entry& entry = m_entries[e];
+        if (entry.prev >= 0)
+            m_entries[entry.prev].next = entry.next;
+        else m_head = entry.next;
+        if (entry.next >= 0)
+            m_entries[entry.next].prev = entry.prev;
+        else m_tail = entry.prev;
+        entry.prev = entry.next = -1;
+    }
+
+    int m_capacity;
+    int m_head;                                     /// most recently used entry
+    int m_tail;                                     /// least recently used entry
+    long m_hits;
+    long m_misses;
+
+    std::vector<Entry> m_entries;
+    std::unordered_map<uint64_t, int> m_index;      /// hash to entry
+};
+
+#endif
+
+
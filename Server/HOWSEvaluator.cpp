@@ -0,0 +1,205 @@
+/* HOWSEvaluator 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$$$$$
+ $   HOWSEvaluator.cpp   $
+ $$$$$$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+*/
+
+
+#ifndef __HOWSEVALUATOR_H__
+#include "HOWSEvaluator.h"
+#endif
+
+#ifndef __HYDPROBLEM_H__
+#include "HydProblem.h"
+#endif
+
+#ifndef __HYDEPANET_H__
+#include "HydEPANET.h"
+#endif
+
+#include <algorithm>
+
+
+HOWSEvaluator::HOWSEvaluator( void ) :  m_problem(nullptr),
+                                        m_epanet(nullptr),
+                                        m_hydNet(nullptr),
+                                        m_own_epanet(0)
+{
+    m_logger.getLogLevel( "HOWSProblem" );
+}
+
+HOWSEvaluator::~HOWSEvaluator( void )
+{
+    clear();
+}
+
+void
+HOWSEvaluator::clear( void )
+{
+    if (m_own_epanet)
+    {
+        delete m_hydNet;
+        delete m_epanet;
+    }
+
+    // we do not own the problem
+    m_problem = nullptr;
+    m_epanet  = nullptr;
+    m_hydNet  = nullptr;
+    m_own_epanet = 0;
+    
+    m_decisions.clear();
+    m_optionValues.clear();
+    m_loaded.clear();
+}
+
+void
+HOWSEvaluator::init( const HydProblem& problem, bool clone )
+{
+    clear();
+
+    m_problem = &problem;
+
+    if (!clone)
+    {
+        m_epanet = problem.getEPANET();
+        m_hydNet = problem.getHydNet();
+    }
+    else
+    {
+        m_own_epanet = 1;
+        m_epanet = new HydEPANET;
+        m_hydNet = m_epanet->load( problem.getEPANET()->fileName(), problem.networkText() );
+        copyProblem( problem );
+    }
+    
+    buildDecisions();
+}
+
+void
+HOWSEvaluator::buildDecisions( void )
+{
+    const std::vector<HydDVariable>& dvariables = m_problem->dvariables();
+    
+    m_decisions.resize(dvariables.size());
+    m_optionValues.clear();
+    m_loaded.clear();
+    
+    for (int i = 0; i < dvariables.size(); ++i)
+    {
+        const HydOptions& options = m_hydNet->options(dvariables[i].hydType(), dvariables[i].group());
+        
+        m_decisions[i].hydType = dvariables[i].hydType();
+        m_decisions[i].index   = dvariables[i].index();
+        m_decisions[i].offset  = (int) m_optionValues.size();
+        
+        m_optionValues.insert(m_optionValues.end(), options.values().begin(), options.values().end());
+    }
+}
+
+void
+HOWSEvaluator::copyProblem( const HydProblem& problem )
+// see HydProblem::load()
+{
+    const HydNetwork* hydNet = problem.getHydNet();
+
+    m_hydNet->setOptions( hydNet->options() );
+    m_hydNet->calculateMinMaxPipeDiameter();
+    m_hydNet->minTHeadDeficit( hydNet->minMaxTHeadDeficit().first );
+    m_hydNet->maxTHeadDeficit( hydNet->minMaxTHeadDeficit().second );
+
+    for (int i = 0; i < problem.dvariables().size(); ++i)
+    {
+        HydNetComp* comp = m_hydNet->findLink( problem.dvariables()[i].ID() );
+
+        comp->setIsDecisionVariable( true );
+        comp->setGroup( problem.dvariables()[i].group() );
+    }
+
+    for (int i = 0; i < problem.constraints().size(); ++i)
+    {
+        HydNetComp* comp = m_hydNet->findNode( problem.constraints()[i].ID() );
+
+        comp->setIsDecisionVariable( true );
+
+        if (comp->hydType() == HydType::Junction)
+            static_cast<HydJunction*>(comp)->setMinHead( problem.constraints()[i].values() );
+    }
+}
+
+void
+HOWSEvaluator::setDecision( int i, int k ) const
+{
+    const Decision& decision = m_decisions[i];
+    HydFloat value = m_optionValues[decision.offset + k];
+    
+    if (decision.hydType == HydType::Pipe)
+    {
+        m_epanet->setDiameter( decision.index, value );
+    }
+    else if (decision.hydType == HydType::Valve)
+    {
+        int status = value;
+        
+        if (status > 0)
+            m_epanet->setValveStatus( decision.index, LinkStatusOption::Open );
+        else m_epanet->setValveStatus( decision.index, LinkStatusOption::Closed );
+    }
+    // add other link types here
+}
+
+void
+HOWSEvaluator::setDecisions( const HHSolution& solution ) const
+{
+    assert(solution.size() == m_decisions.size());
+
+    // update EPANET with the new solution decisions
+    if (m_loaded.size() != solution.size())
+    {
+        for (int i = 0; i < solution.size(); ++i)
+            setDecision( i, solution[i] );
+    }
+    else
+    {
+        for (int i = 0; i < solution.size(); ++i)
+            if (solution[i] != m_loaded[i])
+                setDecision( i, solution[i] );
+    }
+    
+    m_loaded = solution;
+}
+
+HHObjective
+HOWSEvaluator::evaluate( const HHSolution& solution, const std::vector<double>* seedFlows ) const
+{
+    // update EPANET with the new solution decisions
+    setDecisions( solution );
+
+    // run the simulation
+    // this will update diameters, flows, etc in m_hydNet
+    if (seedFlows)
+        m_epanet->run( *seedFlows );
+    else m_epanet->run();
+
+    // pick worst numbers over all scenarios
+    const std::vector<HydFloat>& headDeficit = m_hydNet->headDeficit();
+    const std::vector<HydFloat>& resilience = m_hydNet->resilience();
+
+    // we  want to minimise cost and pressure deficit
+    // the cost does not depend on the simulation - in millions, at the precision of HydNetwork::cost()
+    double c = (HydFloat) (m_problem->costModel().cost(solution) / 1E6);
+    double h = *std::max_element(headDeficit.begin(), headDeficit.end());
+    // resilence has max value of 1.0, can be negative and is to be maximised
+    double r = *std::min_element(resilience.begin(), resilience.end());
+
+    // SSHH  minimises objective values so we use negatove resilence here
+    return {c, h, -r };
+}
+
+//
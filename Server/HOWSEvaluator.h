@@ -0,0 +1,125 @@
+/* HOWSEvaluator 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$$$
+ $   HOWSEvaluator.h   $
+ $$$$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ Evaluates a HOWSProblem solution - the decision variables are written into an EPANET project,
+ the hydraulic simulation is run and the head deficit and resilience are collected from the HydNetwork.
+ The cost does not need the simulation and comes from the problem's HydCostModel
+
+ An evaluator either uses the HydEPANET/HydNetwork owned by a HydProblem, or it owns a clone of them.
+ Clones only read the HydProblem they were cloned from, so different clones can be
+ evaluated concurrently on different threads - see HOWSEvaluatorPool
+
+ The evaluator remembers the solution last written into its EPANET project and only writes the decision
+ variables that differ from it. Code that changes the project's decision variables by other means should
+ call invalidate(). The option values of each decision variable are looked up once, in init().
+
+*/
+
+
+#ifndef __HOWSEVALUATOR_H__
+#define __HOWSEVALUATOR_H__
+
+#ifndef __HHTYPES_H__
+#include "HHTypes.h"
+#endif
+
+#ifndef __HYDTYPES_H__
+#include "HydTypes.h"
+#endif
+
+#ifndef __LOGGER_H__
+#include "ALogger.h"
+#endif
+
+#include <string>
+#include <vector>
+
+class HydProblem;
+class HydEPANET;
+class HydNetwork;
+
+class HOWSEvaluator
+{
+public:
+
+    HOWSEvaluator( void );
+    ~HOWSEvaluator( void );
+
+    // if clone is false use the problem's HydEPANET and HydNetwork, otherwise load a private copy of the network
+    // from the text the problem was loaded from (HydProblem::networkText()), so the copy is the same network even
+    // if the file has changed since - cloning logs messages and should not be called concurrently
+    void
+    init( const HydProblem& problem, bool clone = false );
+
+    // cost, head_deficit, -resiliance
+    // if seedFlows is given the hydraulic solver is warm started from these link flows - see HydEPANET::run()
+    HHObjective
+    evaluate( const HHSolution& solution, const std::vector<double>* seedFlows = nullptr ) const;
+
+    // write the solution decisions (diameters, valve status) into EPANET without running the simulation
+    // only the decisions that differ from the last solution written are changed
+    void
+    setDecisions( const HHSolution& solution ) const;
+    
+    // forget the last solution written - the next setDecisions() writes every decision
+    void
+    invalidate( void ) const { m_loaded.clear(); }
+    
+    HydEPANET*
+    getEPANET( void ) const { return m_epanet; }
+
+    HydNetwork*
+    getHydNet( void ) const { return m_hydNet; }
+
+private:
+
+    HOWSEvaluator( const HOWSEvaluator& )=delete;
+
+    HOWSEvaluator&
+    operator=( const HOWSEvaluator& )=delete;
+
+    void
+    clear( void );
+
+    // copy the problem definition (options, decision variables and constraints) into m_hydNet
+    void
+    copyProblem( const HydProblem& problem );
+    
+    // resolve the EPANET link index and option values of each decision variable
+    void
+    buildDecisions( void );
+    
+    // write decision variable i, option k into EPANET
+    void
+    setDecision( int i, int k ) const;
+    
+    struct Decision
+    {
+        HydType hydType;
+        int     index;          /// EPANET link index
+        int     offset;         /// of the option values in m_optionValues
+    };
+
+    const HydProblem *m_problem;
+    HydEPANET  *m_epanet;
+    HydNetwork *m_hydNet;
+
+    int m_own_epanet;
+    
+    std::vector<Decision> m_decisions;              /// by decision variable
+    std::vector<HydFloat> m_optionValues;           /// the option values of each decision variable
+    mutable HHSolution    m_loaded;                 /// the solution in the EPANET project (empty if unknown)
+
+    mutable Logger m_logger;
+};
+
+#endif
+
+
@@ -0,0 +1,93 @@
+/* HOWSEvaluatorPool 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$$$$$$$$$
+ $   HOWSEvaluatorPool.cpp   $
+ $$$$$$$$$$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+*/
+
+
+#ifndef __HOWSEVALUATORPOOL_H__
+#include "HOWSEvaluatorPool.h"
+#endif
+
+#ifndef __HYDPROBLEM_H__
+#include "HydProblem.h"
+#endif
+
+#ifndef __HYDEPANET_H__
+#include "HydEPANET.h"
+#endif
+
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+
+void
+HOWSEvaluatorPool::clear( void )
+{
+    for (int i = 0; i < m_evaluators.size(); ++i)
+        delete m_evaluators[i];
+
+    m_evaluators.clear();
+    m_results.clear();
+}
+
+void
+HOWSEvaluatorPool::init( const HydProblem& problem, int numWorkers )
+{
+    clear();
+
+    // each clone is parsed from the text the problem was loaded from - see HydProblem::networkText()
+    // load sequentially - loading logs messages and the Logger is not thread safe
+    m_evaluators.resize(numWorkers, nullptr);
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        m_evaluators[i] = new HOWSEvaluator;
+        m_evaluators[i]->init(problem, true);
+    }
+}
+
+const std::vector<HHObjective>&
+HOWSEvaluatorPool::evaluate( const std::vector<HHSolution>& solutions )
+{
+    const int numSolutions = (int) solutions.size();
+    const int numWorkers   = std::min(size(), numSolutions);
+
+    m_results.resize(numSolutions);
+
+    if (numWorkers <= 1)
+    {
+        for (int i = 0; i < numSolutions; ++i)
+            m_results[i] = m_evaluators[0]->evaluate(solutions[i]);
+        return m_results;
+    }
+
+    // each worker takes the next unevaluated solution when it finishes one, so a few slow
+    // extended period simulations do not hold up the rest of the batch
+    std::atomic<int> next(0);
+
+    std::vector<std::thread> workers;
+    workers.reserve(numWorkers);
+
+    for (int w = 0; w < numWorkers; ++w)
+    {
+        workers.emplace_back( [this, w, numSolutions, &solutions, &next]( void )
+        {
+            for (int i = next++; i < numSolutions; i = next++)
+                m_results[i] = m_evaluators[w]->evaluate(solutions[i]);
+        });
+    }
+
+    for (int w = 0; w < numWorkers; ++w)
+        workers[w].join();
+
+    return m_results;
+}
+
+//
@@ -0,0 +1,75 @@
+/* HOWSEvaluatorPool 17/10/2026
+
+ $$$$$$$$$$$$$$$$$$$$$$$$$$$
+ $   HOWSEvaluatorPool.h   $
+ $$$$$$$$$$$$$$$$$$$$$$$$$$$
+
+ by W.B. Yates
+ Copyright (c) University of Exeter. All rights reserved.
+ History:
+
+ A pool of HOWSEvaluators, each with its own clone of the EPANET project, used to evaluate
+ a batch of solutions on several threads at once.
+
+ EPANET 2.2 keeps all of its hydraulic state in the Project struct, so clones can be run
+ concurrently. The network file is read once in init() and each clone is parsed from memory.
+
+ The batch is scheduled dynamically - each evaluator claims the next solution from a shared atomic
+ counter - because the run time of an extended period simulation varies a lot between solutions.
+ Each evaluator writes its objective values into distinct slots of the shared result buffer, so no
+ locking is required.
+
+*/
+
+
+#ifndef __HOWSEVALUATORPOOL_H__
+#define __HOWSEVALUATORPOOL_H__
+
+#ifndef __HOWSEVALUATOR_H__
+#include "HOWSEvaluator.h"
+#endif
+
+#include <vector>
+
+class HOWSEvaluatorPool
+{
+public:
+
+    HOWSEvaluatorPool( void ) : m_evaluators(), m_results() {}
+    ~HOWSEvaluatorPool( void ) { clear(); }
+
+    // create numWorkers evaluators each with a private copy of the problem's network
+    void
+    init( const HydProblem& problem, int numWorkers );
+
+    void
+    clear( void );
+
+    int
+    size( void ) const { return (int) m_evaluators.size(); }
+
+    bool
+    empty( void ) const { return m_evaluators.empty(); }
+
+    HOWSEvaluator*
+    evaluator( int i ) const { return m_evaluators[i]; }
+
+    // evaluate a batch of solutions, one thread per evaluator - result i is the objective of solution i
+    // the returned reference is valid until the next call to evaluate()
+    const std::vector<HHObjective>&
+    evaluate( const std::vector<HHSolution>& solutions );
+
+private:
+
+    HOWSEvaluatorPool( const HOWSEvaluatorPool& )=delete;
+
+    HOWSEvaluatorPool&
+    operator=( const HOWSEvaluatorPool& )=delete;
+
+    std::vector<HOWSEvaluator*> m_evaluators;
+    std::vector<HHObjective>    m_results;
+};
+
+#endif
+
+
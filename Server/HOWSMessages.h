@@ -139,7 +139,7 @@ public:
 
     enum ObjFunc { VOL, SUM };
     
-    OptimiseMessage( void ) : BaseMessage(_OPTIMISE_), m_iters(100), m_seed(64), m_objFuncType(VOL), m_objFuncParams({1.0, 1.0, 2.0})  {}
+    OptimiseMessage( void ) : BaseMessage(_OPTIMISE_), m_iters(100), m_seed(64), m_seconds(0.0), m_objFuncType(VOL), m_objFuncParams({1.0, 1.0, 2.0})  {}
     virtual ~OptimiseMessage( void ) override = default;
     
 
@@ -155,6 +155,13 @@ public:
     void 
     seed( int i ) { m_seed = i; }
     
+    // the wall clock time limit in seconds - 0 implies no limit (the optimiser stops after iters() iterations)
+    double 
+    seconds(void) const { return m_seconds; }
+    
+    void 
+    seconds( double s ) { m_seconds = s; }
+    
     int 
     objFuncType(void) const { return m_objFuncType; }
     
@@ -179,6 +186,7 @@ protected:
 
     int m_iters;
     int m_seed;
+    double m_seconds;
     int m_objFuncType;
     std::vector<ObjType> m_objFuncParams;
     std::vector<int> m_llhs;
@@ -27,6 +27,14 @@
 #include "HydScenarios.h"    
 #endif
 
+#ifndef __HHSOLUTIONOPS_H__
+#include "HHSolutionOps.h"
+#endif
+
+#ifndef __HHBINARY_H__
+#include "HHBinary.h"
+#endif
+
 #ifndef __AFILEFINDER_H__
 #include "AFileFinder.h"
 #endif
@@ -43,6 +51,7 @@ extern "C"
 #include <algorithm> 
 #include <iostream>
 #include <functional>
+#include <limits>
 
 
 ///
@@ -57,13 +66,13 @@ const std::vector<std::string> HOWSProblem::m_llhTypes =
 
 /////////////////////
 
-HOWSProblem::HOWSProblem( const std::string& inst, unsigned int rseed ): HHProblem(), m_param(0.0), m_ran(rseed), m_kbh(m_ran) 
+HOWSProblem::HOWSProblem( const std::string& inst, unsigned int rseed ): HHProblem(), m_param(0.0), m_oldHash(0), m_lastHash(0), m_warmStart(false), m_kbh(m_ran), m_numThreads(1), m_ran(rseed) 
 {
     m_logger.getLogLevel( "HOWSProblem" );
     load(inst);
 }
 
-HOWSProblem::HOWSProblem( void ): HHProblem(), m_param(0.0), m_ran(87), m_kbh(m_ran) 
+HOWSProblem::HOWSProblem( void ): HHProblem(), m_param(0.0), m_oldHash(0), m_lastHash(0), m_warmStart(false), m_kbh(m_ran), m_numThreads(1), m_ran(87) 
 {
     m_logger.getLogLevel( "HOWSProblem" );
 }
@@ -71,6 +80,21 @@ HOWSProblem::HOWSProblem( void ): HHProblem(), m_param(0.0), m_ran(87), m_kbh(m_
 
 HOWSProblem::~HOWSProblem( void )  
 { 
+    if (m_warmStart && m_logger.level() >= 1)
+    {
+        long coldRuns = m_epanet.totalRuns(false), warmRuns = m_epanet.totalRuns(true);
+        double coldIters = (coldRuns) ? m_epanet.totalIterations(false) / (double) coldRuns : 0.0;
+        double warmIters = (warmRuns) ? m_epanet.totalIterations(true) / (double) warmRuns : 0.0;
+        
+        Message txt(1);
+        txt << "Hydraulic solver " << coldRuns << " cold runs with " << coldIters << " iterations per run, " 
+            << warmRuns << " warm runs with " << warmIters << " iterations per run";
+        if (coldIters > 0.0 && warmRuns)
+            txt << " (" << 100.0 * (coldIters - warmIters) / coldIters << "% fewer)";
+        m_logger.logMsg(txt);
+        m_logger.flush();
+    }
+    
   //  if (m_problem.getHydNet())
   //      delete m_problem.getHydNet();
   //  m_problem.getHydNet() = nullptr;
@@ -93,10 +117,7 @@ HOWSProblem::seed( unsigned long s )
 bool
 HOWSProblem::compareSolutions( int mem_idx1, int mem_idx2 ) const
 {
-    for (int i = 0; i < m_problem.dvariables().size(); ++i)
-        if (m_solution[mem_idx1][i] != m_solution[mem_idx2][i])
-            return false;
-    return true;
+    return HHSolutionOps::equal(m_solution[mem_idx1], m_solution[mem_idx2]);
 }
 
 std::string 
@@ -134,13 +155,7 @@ HOWSProblem::toString( void ) const
 double
 HOWSProblem::distance( int mem_idx1, int mem_idx2 ) const
 {
-    double d = 0.0;
-    for (int i = 0; i < m_problem.dvariables().size(); ++i)
-    {
-        double tmp = (double) (m_solution[mem_idx1][i] - m_solution[mem_idx2][i]);
-        d += tmp * tmp;
-    }
-    return sqrt(d);
+    return HHSolutionOps::distance(m_solution[mem_idx1], m_solution[mem_idx2]);
 }
 
 
@@ -162,13 +177,25 @@ void
 HOWSProblem::setMemorySize( int mem_num ) 
 { 
     m_solution.clear(); m_solution.resize(mem_num, HHSolution(m_problem.dvariables().size(), 0));     
+    
+    m_parent.assign(mem_num, -1);
+    m_flows.clear(); m_flows.resize(mem_num);
 }
 
 void 
 HOWSProblem::copySolution( int mem_idx1, int mem_idx2 )  
 { 
     m_solution[mem_idx2] = m_solution[mem_idx1]; 
-    
+    m_parent[mem_idx2]   = m_parent[mem_idx1];
+    m_flows[mem_idx2]    = m_flows[mem_idx1];
+}
+
+void 
+HOWSProblem::setSolution( const HHSolution& sol, int mem_idx )  
+{ 
+    m_solution[mem_idx] = sol; 
+    m_parent[mem_idx] = -1;
+    m_flows[mem_idx].clear();
 }
 
 
@@ -176,7 +203,106 @@ HOWSProblem::copySolution( int mem_idx1, int mem_idx2 )
 HHObjective 
 HOWSProblem::evalauteObj( int mem_idx ) const  
 { 
-    return evalauteObj(m_solution[mem_idx]);  // WDN paper
+    const std::vector<double>* flows = seedFlows(mem_idx);
+    const HHSolution& solution = m_solution[mem_idx];
+    
+    // solutions are usually a few decision variables away from the last one simulated
+    const uint64_t hash = HHSolutionOps::rehash(m_oldHash, m_oldSolution, solution);
+    
+    HHObjective value;
+    if (!m_cache.find(solution, hash, value))
+    {
+        value = simulate(solution, hash, flows);
+        m_cache.insert(solution, hash, value);
+    }
+    
+    setLastSolution(mem_idx, hash, flows);
+    return value;
+}
+
+void
+HOWSProblem::evaluated( int mem_idx, const HHObjective& )
+{
+    const HHSolution& solution = m_solution[mem_idx];
+    setLastSolution(mem_idx, HHSolutionOps::rehash(m_oldHash, m_oldSolution, solution), seedFlows(mem_idx));
+}
+
+const std::vector<double>*
+HOWSProblem::seedFlows( int mem_idx ) const
+{
+    if (!m_warmStart)
+        return nullptr;
+    
+    // start from the flows of the parent solution, otherwise from this slot's previous flows
+    int parent = m_parent[mem_idx];
+    if (parent >= 0 && !m_flows[parent].empty())
+        return &m_flows[parent];
+    if (!m_flows[mem_idx].empty())
+        return &m_flows[mem_idx];
+    return nullptr;
+}
+
+void
+HOWSProblem::setLastSolution( int mem_idx, uint64_t hash, const std::vector<double>* seedFlows ) const
+{
+    const HHSolution& solution = m_solution[mem_idx];
+    
+    // if the network does not hold this solution (its value came from the cache) it is 
+    // simulated again, from the same flows, when an LLH reads the network - see syncNetwork()
+    m_lastSolution = solution;
+    m_lastHash = hash;
+    if (holds(solution, hash))
+    {
+        m_lastFlows.clear();
+        if (m_warmStart)
+            m_flows[mem_idx] = m_epanet.initialFlows();
+    }
+    else if (seedFlows)
+    {
+        // the slot's children start from the flows its own simulation started from
+        m_lastFlows = *seedFlows;
+        m_flows[mem_idx] = m_lastFlows;
+    }
+    else m_lastFlows.clear();
+}
+
+HHObjective
+HOWSProblem::simulate( const HHSolution& solution, uint64_t hash, const std::vector<double>* seedFlows ) const
+{
+    HHObjective value = m_evaluator.evaluate(solution, seedFlows);
+    m_oldSolution = solution;
+    m_oldHash = hash;
+    return value;
+}
+
+bool
+HOWSProblem::holds( const HHSolution& solution, uint64_t hash ) const
+{
+    return !m_oldSolution.empty() && m_oldHash == hash && HHSolutionOps::equal(m_oldSolution, solution);
+}
+
+void
+HOWSProblem::syncNetwork( void ) const
+{
+    if (m_lastSolution.empty() || holds(m_lastSolution, m_lastHash))
+        return;
+    
+    simulate(m_lastSolution, m_lastHash, (m_lastFlows.empty()) ? nullptr : &m_lastFlows);
+    m_lastFlows.clear();
+}
+
+HHObjective
+HOWSProblem::cachedObj( const HHSolution& solution ) const
+{
+    const uint64_t hash = HHSolutionOps::rehash(m_oldHash, m_oldSolution, solution);
+    
+    HHObjective value;
+    if (!m_cache.find(solution, hash, value))
+    {
+        value = simulate(solution, hash, nullptr);
+        m_cache.insert(solution, hash, value);
+    }
+    return value;
 }
 
 std::vector<std::string>
@@ -205,6 +331,7 @@ void
 HOWSProblem::applyHeuristic( int h_id, int mem_idx1, int mem_idx2 ) 
 {
     m_solution[mem_idx2] = m_solution[mem_idx1];
+    m_parent[mem_idx2]   = mem_idx1;
     
     switch (h_id)
     {
@@ -217,9 +344,11 @@ HOWSProblem::applyHeuristic( int h_id, int mem_idx1, int mem_idx2 )
         // 5 is reserved for 2 point cross over
 
         case 6 :  m_kbh.kb_block_creep(m_solution[mem_idx2], m_param); break; 
-        case 7 :  m_kbh.kb_bottleneck(m_solution[mem_idx2], m_param); break; 
-        case 8 :  m_kbh.kb_pipesmooth(m_solution[mem_idx2], m_param); break; 
-        case 9 :  hd_heuristic(m_solution[mem_idx2], m_param); break; 
+            
+        // these read the simulation of the last solution evaluated 
+        case 7 :  syncNetwork(); m_kbh.kb_bottleneck(m_solution[mem_idx2], m_param); break; 
+        case 8 :  syncNetwork(); m_kbh.kb_pipesmooth(m_solution[mem_idx2], m_param); break; 
+        case 9 :  syncNetwork(); hd_heuristic(m_solution[mem_idx2], m_param); break; 
 
         default:
             if (m_logger.level() >= 1)
@@ -237,6 +366,8 @@ HOWSProblem::applyHeuristic( int h_id, int mem_idx1, int mem_idx2 )
 void 
 HOWSProblem::applyHeuristic( int h_id, int mem_idx1, int mem_idx2, int mem_idx3 ) 
 {
+    m_parent[mem_idx3] = mem_idx1;
+    
     switch (h_id)
     {
         case 5 :  crossover2(m_solution[mem_idx1], m_solution[mem_idx2], m_solution[mem_idx3], m_param); break;
@@ -261,6 +392,35 @@ HOWSProblem::load( const std::string& instance_id )
 {
     m_problem.init(&m_epanet);
     m_problem.load(instance_id);
+    
+    // every option index must fit in a DVType (one byte if HH_COMPACT_SOLUTION is defined)
+    for (int i = 0; i < m_problem.options().size(); ++i)
+    {
+        if (m_problem.options()[i].size() - 1 > std::numeric_limits<DVType>::max())
+        {
+            if (m_logger.level() >= 1)
+            {
+                Message txt(1);
+                txt << "Decision variable " << m_problem.dvariables()[i].ID() << " has " << m_problem.options()[i].size() 
+                    << " options, the maximum is " << (int) std::numeric_limits<DVType>::max() + 1;
+                m_logger.logMsg(txt);
+                m_logger.flush();
+            }
+            exit(EXIT_FAILURE);
+        }
+    }
+    
+    m_evaluator.init(m_problem);
+    m_cache.clear();
+    m_oldSolution.clear();
+    m_oldHash = 0;
+    m_lastSolution.clear();
+    m_lastHash = 0;
+    m_lastFlows.clear();
+    
+    if (m_numThreads > 1)
+        m_pool.init(m_problem, m_numThreads);
+    else m_pool.clear();
 
   
     // used for random selection of elements of type t - see def of rndType() in HOWSProblem.h
@@ -298,51 +458,161 @@ HOWSProblem::evalauteObj( const HHSolution& solution ) const
 {
     assert(solution.size() == m_problem.dvariables().size());
 
-    if (!m_oldSolution.empty() && m_oldSolution == solution)
-        return m_oldValue;
+    const uint64_t hash = HHSolutionOps::rehash(m_oldHash, m_oldSolution, solution);
     
-    // update EPANET with the new solution decisions
-    for (int i = 0; i < m_problem.dvariables().size(); ++i)
+    // the caller reads getHydNet() so the cached value is only used if m_epanet holds the solution
+    HHObjective value;
+    if (!holds(solution, hash) || !m_cache.find(solution, hash, value))
     {
-        if (m_problem.dvariables()[i].hydType() == HydType::Pipe)
+        value = simulate(solution, hash, nullptr);
+        m_cache.insert(solution, hash, value);
+    }
+    
+    m_lastSolution = solution;
+    m_lastHash = hash;
+    m_lastFlows.clear();
+    
+    return value;
+}
+
+void
+HOWSProblem::sweep( const HHSolution& solution, int idx, const std::function<void(int)>& result ) const
+{
+    assert(solution.size() == m_problem.dvariables().size());
+    assert(m_problem.dvariables()[idx].hydType() == HydType::Pipe);
+    
+    const HydDVariable& dvariable = m_problem.dvariables()[idx];
+    const HydOptions& options = m_problem.getHydNet()->options(HydType::Pipe, dvariable.group());
+    
+    m_evaluator.setDecisions(solution);
+    m_epanet.sweepDiameter(dvariable.index(), options.values(), solution[idx], result);
+    
+    // m_epanet and getHydNet() no longer hold the values for the cached solution
+    // and the link's original diameter is restored from EPANET (in user units) so rewrite it next time
+    m_oldSolution.clear();
+    m_oldHash = 0;
+    m_evaluator.invalidate();
+}
+
+std::vector<HHObjective>
+HOWSProblem::evalauteObj( const std::vector<HHSolution>& solutions ) const
+{
+    if (m_pool.empty())
+    {
+        std::vector<HHObjective> results(solutions.size());
+        for (int i = 0; i < solutions.size(); ++i)
+            results[i] = cachedObj(solutions[i]);
+        return results;
+    }
+    
+    // only the solutions that are not in the cache are given to the pool
+    std::vector<HHObjective> results(solutions.size());
+    std::vector<HHSolution> misses;
+    std::vector<int> missIdx;
+    for (int i = 0; i < solutions.size(); ++i)
+    {
+        if (!m_cache.find(solutions[i], results[i]))
         {
-            HydOptions options = m_problem.getHydNet()->options(HydType::Pipe, m_problem.dvariables()[i].group());
-            HydFloat diam = options.value(solution[i]); 
-            
-            m_epanet.setDiameter( m_problem.dvariables()[i].index(), diam );
+            misses.push_back(solutions[i]);
+            missIdx.push_back(i);
         }
-        else if (m_problem.dvariables()[i].hydType() == HydType::Valve)
+    }
+    
+    if (!misses.empty())
+    {
+        std::vector<HHObjective> values = m_pool.evaluate(misses);
+        for (int i = 0; i < misses.size(); ++i)
         {
-            HydOptions options = m_problem.getHydNet()->options(HydType::Valve, m_problem.dvariables()[i].group());
-            int status = options.value(solution[i]); 
-            
-            if (status > 0)
-                m_epanet.setValveStatus( m_problem.dvariables()[i].index(), LinkStatusOption::Open );
-            else m_epanet.setValveStatus( m_problem.dvariables()[i].index(), LinkStatusOption::Closed );
+            results[missIdx[i]] = values[i];
+            m_cache.insert(misses[i], values[i]);
         }
-        // add other link types here
     }
+    
+    return results;
+}
 
-    // run the simulation
-    // this will update diameters, flows, etc in m_problem.getHydNet()
-    m_epanet.run();
+void
+HOWSProblem::writeState( std::ostream& ostr ) const
+{
+    HHBinary::write(ostr, m_lastSolution);
+    HHBinary::write(ostr, m_lastFlows);
+    HHBinary::write(ostr, m_parent);
+    HHBinary::write(ostr, m_flows);
+}
 
-    // cache this run's values; pick worst numbers over all scenarios
-    const std::vector<HydFloat>& cost = m_problem.getHydNet()->cost();
-    const std::vector<HydFloat>& headDeficit = m_problem.getHydNet()->headDeficit();
-    const std::vector<HydFloat>& resilience = m_problem.getHydNet()->resilience();
+bool
+HOWSProblem::readState( std::istream& istr )
+{
+    HHSolution lastSolution;
+    std::vector<double> lastFlows;
+    std::vector<int> parent;
+    std::vector<std::vector<double>> flows;
+    
+    if (!HHBinary::read(istr, lastSolution) || !HHBinary::read(istr, lastFlows) || 
+        !HHBinary::read(istr, parent) || !HHBinary::read(istr, flows))
+        return false;
     
-    // we  want to minimise cost and pressure deficit
-    double c = *std::max_element(cost.begin(), cost.end());      
-    double h = *std::max_element(headDeficit.begin(), headDeficit.end());  
-    // resilence has max value of 1.0, can be negative and is to be maximised
-    double r = *std::min_element(resilience.begin(), resilience.end());
+    if ((!lastSolution.empty() && lastSolution.size() != m_problem.dvariables().size()) || 
+        parent.size() != m_solution.size() || flows.size() != m_solution.size())
+        return false;
+    
+    for (int i = 0; i < parent.size(); ++i)
+    {
+        if (parent[i] < -1 || parent[i] >= (int) m_solution.size())
+            return false;
+    }
+    
+    // m_epanet is brought in line with the last solution by syncNetwork() when an LLH reads it
+    m_lastSolution = lastSolution;
+    m_lastHash     = (lastSolution.empty()) ? 0 : HHSolutionOps::hash(lastSolution);
+    m_lastFlows    = lastFlows;
+    m_parent       = parent;
+    m_flows        = flows;
+    return true;
+}
 
-    // SSHH  minimises objective values so we use negatove resilence here
-    m_oldValue = {c, h, -r };
-    m_oldSolution = solution;
+HydRunHistogram
+HOWSProblem::solverMetrics( void ) const
+{
+    HydRunHistogram metrics = m_epanet.runHistogram();
+    
+    for (int i = 0; i < m_pool.size(); ++i)
+        metrics.add( m_pool.evaluator(i)->getEPANET()->runHistogram() );
     
-    return m_oldValue;
+    return metrics;
+}
+
+std::vector<std::string>
+HOWSProblem::statisticsLog( void ) const
+{
+    std::vector<std::string> stats;
+    
+    long lookups = m_cache.hits() + m_cache.misses();
+    
+    std::ostringstream str;
+    str << "Evaluation cache " << m_cache.size() << "/" << m_cache.capacity() << " entries, " 
+        << m_cache.hits() << " hits, " << m_cache.misses() << " misses";
+    if (lookups)
+        str << " (" << 100.0 * m_cache.hits() / lookups << "% of evaluations saved)";
+    stats.push_back(str.str());
+    
+    std::vector<std::string> metrics = solverMetrics().toStrings();
+    stats.insert(stats.end(), metrics.begin(), metrics.end());
+    return stats;
+}
+
+void
+HOWSProblem::setNumThreads( int numThreads )
+{
+    m_numThreads = std::max(1, numThreads);
+    
+    // already loaded
+    if (m_problem.getHydNet())
+    {
+        if (m_numThreads > 1)
+            m_pool.init(m_problem, m_numThreads);
+        else m_pool.clear();
+    }
 }
 
 
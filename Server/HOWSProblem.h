@@ -35,6 +35,14 @@
 #include "HydEPANET.h"
 #endif
 
+#ifndef __HOWSEVALUATORPOOL_H__
+#include "HOWSEvaluatorPool.h"
+#endif
+
+#ifndef __HOWSEVALCACHE_H__
+#include "HOWSEvalCache.h"
+#endif
+
 #ifndef __HDHEURISTIC_H__
 #include "HDHeuristic.h"
 #endif
@@ -53,6 +61,7 @@
 
 #include <vector>
 #include <cmath>
+#include <functional>
 
 class HOWSProblem : public HHProblem 
 {
@@ -113,6 +122,9 @@ public:
     void 
     copySolution( int mem_idx1, int mem_idx2 ) override;
     
+    void
+    setSolution( const HHSolution& sol, int mem_idx ) override;
+    
     // cost, head_deficit, resiliance
     HHObjective 
     evalauteObj( int mem_idx ) const override ;
@@ -130,6 +142,38 @@ public:
     double
     distance( int mem_idx1, int mem_idx2 ) const override;
 
+    URand*
+    getRandom( void ) override { return &m_ran; }
+    
+    //  BOTTLENECK, PIPESMOOTH and HDH read the simulation of the last solution evaluated
+    std::vector<int>
+    getHeuristicsThatReadState( void ) const override { return std::vector<int>({7,8,9}); }
+    
+    //  a warm started simulation depends on the flows it starts from
+    bool
+    repeatableEvaluation( void ) const override { return !m_warmStart; }
+    
+    void
+    evaluated( int mem_idx, const HHObjective& value ) override;
+    
+    //  The last solution evaluated, its warm start flows and the parent and flows of each memory slot - not the 
+    //  evaluation cache, which starts empty. The network is simulated again for the last solution when an LLH 
+    //  reads it, so a resumed run follows the same trajectory; with warm start on the objective values only
+    //  agree to within the hydraulic solver's tolerance (a value may now be simulated that was cached before)
+    void
+    writeState( std::ostream& ostr ) const override;
+    
+    bool
+    readState( std::istream& istr ) override;
+    
+    //  Evaluate a batch of solutions on the evaluator pool - see evalauteObj( const std::vector<HHSolution>& )
+    std::vector<HHObjective>
+    evaluateBatch( const std::vector<HHSolution>& solutions ) override { return evalauteObj(solutions); }
+    
+    //  The evaluators in the pool, 1 without a pool - see setNumThreads()
+    int
+    numWorkers( void ) const override { return (m_pool.empty()) ? 1 : m_pool.size(); }
+
     
     //
     // HOWSServer interface
@@ -145,10 +189,54 @@ public:
     HydNetwork* 
     getHydNet( void ) { return m_problem.getHydNet(); }
     
-    //!<  Evaluate a solution
+    //!<  The cost of a solution without simulation (the cost objective of evalauteObj() in millions)
+    const HydCostModel&
+    costModel( void ) const { return m_problem.costModel(); }
+    
+    //!<  Evaluate a solution - getHydNet() then holds its simulation
     HHObjective
     evalauteObj( const HHSolution& solution ) const;
     
+    //!<  Look ahead - evaluate solution once for each option of decision variable idx (a pipe)
+    //!<  result(i) is called when getHydNet() holds the values for option i - see HydEPANET::sweepDiameter()
+    void
+    sweep( const HHSolution& solution, int idx, const std::function<void(int)>& result ) const;
+    
+    //!<  Evaluate a batch of solutions - concurrently if numThreads() > 1
+    //!<  Only the objective values are returned, getHydNet() and the LLHs are not affected
+    std::vector<HHObjective>
+    evalauteObj( const std::vector<HHSolution>& solutions ) const;
+    
+    //!<  The number of EPANET projects used by the batch evaluateObj() (default 1) - set before load()
+    void
+    setNumThreads( int numThreads );
+    
+    int
+    numThreads( void ) const { return m_numThreads; }
+    
+    //!<  Warm start - the hydraulic solver for a solution in memory starts from the converged link flows 
+    //!<  of the solution it was derived from by a low level heuristic (default false)
+    void
+    setWarmStart( bool warmStart ) { m_warmStart = warmStart; }
+    
+    bool
+    warmStart( void ) const { return m_warmStart; }
+    
+    //!<  The number of evaluations kept by the evaluation cache (default 4096, 0 disables the cache)
+    void
+    setCacheSize( int cacheSize ) { m_cache.setCapacity(cacheSize); }
+    
+    const HOWSEvalCache&
+    evalCache( void ) const { return m_cache; }
+    
+    //!<  Hydraulic solver telemetry aggregated over every simulation run since load(), including the evaluator pool
+    HydRunHistogram
+    solverMetrics( void ) const;
+    
+    //!<  The evaluation cache statistics and solverMetrics() histograms - logged by SSHH at the end of a run
+    std::vector<std::string>
+    statisticsLog( void ) const override;
+    
     void 
     initialiseSolution( HHSolution& solution );
 
@@ -212,6 +300,35 @@ protected:
     
     /// end of low level heuristics      
 
+    
+    //
+    // simulation state
+    //
+    
+    //!<  the warm start flows for the solution in mem_idx, nullptr for a cold start
+    const std::vector<double>*
+    seedFlows( int mem_idx ) const;
+    
+    //!<  make the solution in mem_idx the last solution evaluated, which the network should reflect
+    void
+    setLastSolution( int mem_idx, uint64_t hash, const std::vector<double>* seedFlows ) const;
+    
+    //!<  run m_evaluator on solution, m_epanet then holds it
+    HHObjective
+    simulate( const HHSolution& solution, uint64_t hash, const std::vector<double>* seedFlows ) const;
+    
+    //!<  true if m_epanet holds the last simulation of solution (whose hash is hash)
+    bool
+    holds( const HHSolution& solution, uint64_t hash ) const;
+    
+    //!<  simulate m_lastSolution again if m_epanet no longer holds it - called before the LLHs that read the network
+    void
+    syncNetwork( void ) const;
+    
+    //!<  the objective value of solution from the cache, otherwise simulated - the network state is not tracked
+    HHObjective
+    cachedObj( const HHSolution& solution ) const;
+
 
     
     double m_param;                                 /// low level heuritsic parameter (if required)
@@ -221,14 +338,25 @@ protected:
     
     std::vector<double> m_pipeInfluence;
     
-    mutable HHSolution  m_oldSolution;              /// last solution cached 
-    mutable HHObjective m_oldValue;                 /// last solution's objective functions cached
+    mutable HOWSEvalCache m_cache;                  /// recent solutions and their objective functions
+    mutable HHSolution  m_oldSolution;              /// the solution of the last simulation run by m_evaluator
+    mutable uint64_t    m_oldHash;                  /// HHSolutionOps::hash() of m_oldSolution
+    mutable HHSolution  m_lastSolution;             /// the last solution evaluated by evalauteObj(), which the network should reflect
+    mutable uint64_t    m_lastHash;                 /// HHSolutionOps::hash() of m_lastSolution
+    mutable std::vector<double> m_lastFlows;        /// the warm start flows of m_lastSolution if it came from the cache
+    
+    bool m_warmStart;
+    std::vector<int> m_parent;                      /// the memory slot each solution was derived from (-1 if none)
+    mutable std::vector<std::vector<double>> m_flows; /// converged link flows of each memory slot's last evaluation
 
     KBHeuristic m_kbh;                              /// Knowledge Based Heuristics
     HDHeuristic m_hdh;                              /// Human Derived Heuristics
     
     HydProblem  m_problem;                          /// The decision variables, options and constraints
     HydEPANET   m_epanet;                           /// The haudralic simulator which loads/runs a network
+    HOWSEvaluator m_evaluator;                      /// evaluates solutions using m_epanet
+    mutable HOWSEvaluatorPool m_pool;               /// clones of m_epanet for concurrent evaluation
+    int m_numThreads;
     URand m_ran;
     
     mutable Logger m_logger;
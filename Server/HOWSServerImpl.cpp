@@ -476,7 +476,6 @@ HOWSServerImpl::lookAhead( const LookAheadMessage& msg )
             if (pipe->isDecisionVariable())
             {
                 const HydOptions& diams = m_hydNet->options( HydType::Pipe, pipe->group() );
-                std::vector<HHSolution>   solutions(diams.values().size(), m_current_solution);
                 const int numDiams = (int) diams.values().size();
                 
                 // only link components can be decision variables - otherwise comp->index() is not unique
@@ -491,13 +490,21 @@ HOWSServerImpl::lookAhead( const LookAheadMessage& msg )
                 {
                     avail_diams.push_back(diams.value(i));
                     avail_diams_cost.push_back(diams.cost(i) * pipe->length());
+                }
+                
+                for (int j = 0; j < numScenarios; ++j)
+                    obj_values[j].resize(numDiams);
+                
+                // only this pipe changes so the cost of each diameter follows from the cost of the existing solution
+                const HydCostModel& costModel = m_problem->costModel();
+                const double currentCost = costModel.cost(m_current_solution);
+                
+                // evaluate the existing solution with each diameter for this pipe
+                // the sweep does not visit the diameters in order
+                m_problem->sweep(m_current_solution, idx, [&]( int i )
+                {
+                    const HydFloat cost = (currentCost + costModel.deltaCost(idx, currentDiamIdx, i)) / 1E6;
                     
-                    // modify existing solution and evaluate
-                    solutions[i][idx] = i;
-                    
-                    // this will clear the networks simulation and objective function values
-                    m_problem->evalauteObj(solutions[i]);
-            
                     for (int j = 0; j < numScenarios; ++j)
                     {
                         // WARNING: this is done in original code
@@ -506,19 +513,19 @@ HOWSServerImpl::lookAhead( const LookAheadMessage& msg )
                         if (resilience < 0.0)
                             resilience = 0.0;
                         
-                        HydObjectives results({m_hydNet->cost(j), m_hydNet->headDeficit(j), resilience});
+                        HydObjectives results({cost, m_hydNet->headDeficit(j), resilience});
                         
-                        obj_values[j].push_back( results );
+                        obj_values[j][i] = results;
                         
                         if (currentDiamIdx == i)
                             obj_cur[j] = results;
                     }
-                }
+                });
                 
                 if (m_logger.level() >= 2)
                 {
                     Message txt1(2);
-                    txt1 << solutions.size() << " evaluations performed ";
+                    txt1 << numDiams << " evaluations performed ";
                     m_logger.logMsg(txt1);
                     m_logger.flush();
                 }
@@ -605,7 +612,7 @@ HOWSServerImpl::change( const ChangeMessage& msg )
                         if (m_logger.level() >= 2)
                         {
                             Message txt1(2);
-                            txt1 << "Changed pipe " << msg.ID() << " diameter index from " <<  m_current_solution[idx] << " to " << msg.value() ;
+                            txt1 << "Changed pipe " << msg.ID() << " diameter index from " << (int) m_current_solution[idx] << " to " << msg.value() ;
                             m_logger.logMsg(txt1);
                             m_logger.flush();
                         }
@@ -655,7 +662,10 @@ HOWSServerImpl::optimise( const OptimiseMessage& msg )
         if (m_logger.level() >= 1)
         {
             Message txt1(1);
-            txt1 << "Optimise network " << m_hydNet->name() << " for " << msg.iters() << " iterations with seed " << msg.seed();
+            txt1 << "Optimise network " << m_hydNet->name() << " for " << msg.iters() << " iterations";
+            if (msg.seconds() > 0.0)
+                txt1 << " (at most " << msg.seconds() << " seconds)";
+            txt1 << " with seed " << msg.seed();
             m_logger.logMsg(txt1);
             m_logger.flush();
         }
@@ -676,10 +686,14 @@ HOWSServerImpl::optimise( const OptimiseMessage& msg )
         sshh.seed(msg.seed());
         sshh.initialise(*m_problem, m_current_solution, my_objFunc, omitLLH); 
 
-        // run the optimiser
+        // run the optimiser - for at most msg.iters() iterations and msg.seconds() seconds
+        HHBudget budget( msg.iters() );
+        if (msg.seconds() > 0.0)
+            budget.setSeconds( msg.seconds() );
+        
         sshh.logProblem( msg.iters() );
         sshh.beginRunLog();
-        sshh.solve( msg.iters() );
+        sshh.solve( budget );
         sshh.endRunLog();
 
         m_current_solution = m_problem->getSolution(SSHH::BEST_SOL);
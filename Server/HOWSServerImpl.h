@@ -16,6 +16,8 @@
  
  curl -i -X PUT -H 'Content-Type: application/json' -d '{"msgtype":"Optimise", "seed":1, "iterations":1000,"user":"bill", "llhs":[], "obj_type":0, "obj_params":[1,1,2]}' http://127.0.0.1:8000/HOWS
  
+ an Optimise message may also limit the optimiser's wall clock time e.g. "seconds":20
+ 
  curl -i -X PUT -H 'Content-Type: application/json' -d '{"msgtype":"DB","name":"two_loop","cmd":0,"user":"bill"}' http://127.0.0.1:8000/HOWS
  
  see HOWSMessages.h for other message formats
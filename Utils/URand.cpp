@@ -67,6 +67,26 @@ URand::reset( unsigned int s, unsigned long p )
         ran();
 }
 
+void
+URand::write( std::ostream& ostr ) const
+{
+    ostr.write( reinterpret_cast<const char*>(&m_count), sizeof(m_count) );
+    ostr.write( reinterpret_cast<const char*>(&m_seed), sizeof(m_seed) );
+    ostr.write( reinterpret_cast<const char*>(&m_idum), sizeof(m_idum) );
+    ostr.write( reinterpret_cast<const char*>(&m_iy), sizeof(m_iy) );
+    ostr.write( reinterpret_cast<const char*>(m_iv), sizeof(m_iv) );
+}
+
+bool
+URand::read( std::istream& istr )
+{
+    istr.read( reinterpret_cast<char*>(&m_count), sizeof(m_count) );
+    istr.read( reinterpret_cast<char*>(&m_seed), sizeof(m_seed) );
+    istr.read( reinterpret_cast<char*>(&m_idum), sizeof(m_idum) );
+    istr.read( reinterpret_cast<char*>(&m_iy), sizeof(m_iy) );
+    istr.read( reinterpret_cast<char*>(m_iv), sizeof(m_iv) );
+    return (bool) istr;
+}
 
 double 
 URand::ran1( long &idum )
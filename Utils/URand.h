@@ -56,6 +56,14 @@ public:
     //!< reset the sequence
     void
     reset( void ) { seed( m_seed ); }
+
+    //!< write/read the complete state in binary - a restored generator continues the same sequence
+    //!< without replaying it (cf. operator<< and operator>>)
+    void
+    write( std::ostream& ostr ) const;
+
+    bool
+    read( std::istream& istr );
 	
 private:
     